@@ -5,6 +5,7 @@
 #include <AMReX_Geometry.H>
 #include <AMReX_FArrayBox.H>
 #include <AMReX_NonLocalBC.H>
+#include <AMReX_OpenMP.H>
 
 #include <AMReX_BArena.H>
 #include <AMReX_CArena.H>
@@ -72,6 +73,7 @@ std::multimap<FabArrayBase::BDKey,FabArrayBase::ParForInfo*> FabArrayBase::m_The
 
 FabArrayBase::CacheStats           FabArrayBase::m_TAC_stats("TileArrayCache");
 FabArrayBase::CacheStats           FabArrayBase::m_FBC_stats("FBCache");
+double                             FabArrayBase::m_FB_time = 0.0;
 FabArrayBase::CacheStats           FabArrayBase::m_CPC_stats("CopyCache");
 FabArrayBase::CacheStats           FabArrayBase::m_FPinfo_stats("FillPatchCache");
 FabArrayBase::CacheStats           FabArrayBase::m_CFinfo_stats("CrseFineCache");
@@ -1179,6 +1181,17 @@ FabArrayBase::FB::define_os (const FabArrayBase& fa)
     // due to the way they are built.
 }
 
+FabArrayBase::FBTimer::FBTimer () noexcept
+    : m_start(amrex::second())
+{}
+
+FabArrayBase::FBTimer::~FBTimer ()
+{
+    if (!OpenMP::in_parallel()) {
+        m_FB_time += amrex::second() - m_start;
+    }
+}
+
 void
 FabArrayBase::flushFB (bool no_assertion) const
 {
@@ -35,6 +35,8 @@
 #include <stack>
 #include <list>
 #include <chrono>
+#include <algorithm>
+#include <utility>
 
 #ifdef BL_USE_MPI
 namespace
@@ -62,6 +64,8 @@ namespace amrex::ParallelDescriptor {
     bool use_gpu_aware_mpi = false;
 #endif
 
+    std::atomic<Long> num_allreduces{0};
+
     ProcessTeam m_Team;
 
     MPI_Comm m_comm = MPI_COMM_NULL;    // communicator for all ranks, probably MPI_COMM_WORLD
@@ -543,6 +547,66 @@ IProbe (int src_pid, int tag, MPI_Comm comm, int& flag, MPI_Status& status)
     BL_COMM_PROFILE(BLProfiler::Iprobe, flag, BLProfiler::AfterCall(), status.MPI_TAG);
 }
 
+void
+SparseHandShake (Vector<int> const& snd_procs, Vector<Long> const& snd_data,
+                 Vector<int>& rcv_procs, Vector<Long>& rcv_data,
+                 int tag, MPI_Comm comm)
+{
+    BL_PROFILE_S("ParallelDescriptor::SparseHandShake()");
+
+    AMREX_ASSERT(snd_procs.size() == snd_data.size());
+
+    const auto nsnds = static_cast<int>(snd_procs.size());
+    const auto mpi_long = Mpi_typemap<Long>::type();
+
+    // Synchronous sends complete only after they have been matched by
+    // the receivers.
+    Vector<MPI_Request> sreqs(nsnds);
+    for (int i = 0; i < nsnds; ++i) {
+        BL_MPI_REQUIRE( MPI_Issend(&snd_data[i], 1, mpi_long, snd_procs[i], tag, comm,
+                                   &sreqs[i]) );
+    }
+
+    // Receive until all processes have seen their sends matched, which is
+    // known when the barrier started after that completes.
+    Vector<std::pair<int,Long>> rcvd;
+    MPI_Request barrier_req = MPI_REQUEST_NULL;
+    bool barrier_started = false;
+    while (true) {
+        int flag;
+        MPI_Status status;
+        BL_MPI_REQUIRE( MPI_Iprobe(MPI_ANY_SOURCE, tag, comm, &flag, &status) );
+        if (flag) {
+            Long val;
+            BL_MPI_REQUIRE( MPI_Recv(&val, 1, mpi_long, status.MPI_SOURCE, tag, comm,
+                                     MPI_STATUS_IGNORE) );
+            rcvd.emplace_back(status.MPI_SOURCE, val);
+        }
+
+        if (barrier_started) {
+            int done;
+            BL_MPI_REQUIRE( MPI_Test(&barrier_req, &done, MPI_STATUS_IGNORE) );
+            if (done) { break; }
+        } else {
+            int sent;
+            BL_MPI_REQUIRE( MPI_Testall(nsnds, sreqs.data(), &sent, MPI_STATUSES_IGNORE) );
+            if (sent) {
+                BL_MPI_REQUIRE( MPI_Ibarrier(comm, &barrier_req) );
+                barrier_started = true;
+            }
+        }
+    }
+
+    std::sort(rcvd.begin(), rcvd.end());
+    const auto nrcvs = static_cast<int>(rcvd.size());
+    rcv_procs.resize(nrcvs);
+    rcv_data.resize(nrcvs);
+    for (int i = 0; i < nrcvs; ++i) {
+        rcv_procs[i] = rcvd[i].first;
+        rcv_data[i] = rcvd[i].second;
+    }
+}
+
 void
 Comm_dup (MPI_Comm comm, MPI_Comm& newcomm)
 {
@@ -1209,6 +1273,20 @@ void Test (Vector<MPI_Request>&, int&, Vector<MPI_Status>&) {}
 void IProbe (int, int, int&, MPI_Status&) {}
 void IProbe (int, int, MPI_Comm, int&, MPI_Status&) {}
 
+void SparseHandShake (Vector<int> const& snd_procs, Vector<Long> const& snd_data,
+                      Vector<int>& rcv_procs, Vector<Long>& rcv_data,
+                      int /*tag*/, MPI_Comm /*comm*/)
+{
+    rcv_procs.clear();
+    rcv_data.clear();
+    for (int i = 0; i < static_cast<int>(snd_procs.size()); ++i) {
+        if (snd_procs[i] == 0) {
+            rcv_procs.push_back(0);
+            rcv_data.push_back(snd_data[i]);
+        }
+    }
+}
+
 void Comm_dup (MPI_Comm, MPI_Comm&) {}
 
 void ReduceRealSum (Vector<std::reference_wrapper<Real> > const& /*rvar*/) {}
@@ -68,12 +68,14 @@ Hypre::setScalars (Real sa, Real sb)
 {
     scalar_a = sa;
     scalar_b = sb;
+    m_coeffs_changed = true;
 }
 
 void
 Hypre::setACoeffs (const MultiFab& alpha)
 {
     MultiFab::Copy(acoefs, alpha, 0, 0, 1, 0);
+    m_coeffs_changed = true;
 }
 
 void
@@ -83,6 +85,7 @@ Hypre::setBCoeffs (const Array<const MultiFab*, BL_SPACEDIM>& beta)
         const int ng = std::min(bcoefs[idim].nGrow(), beta[idim]->nGrow());
         MultiFab::Copy(bcoefs[idim], *beta[idim], 0, 0, 1, ng);
     }
+    m_coeffs_changed = true;
 }
 
 void
@@ -43,6 +43,9 @@ HypreABecLap::solve (MultiFab& soln, const MultiFab& rhs, Real reltol, Real abst
     else
     {
         m_factory = &(rhs.Factory());
+        if (m_coeffs_changed) {
+            updateMatrix();
+        }
     }
 
     // do this repeatedly to avoid memory leak
@@ -76,6 +79,7 @@ HypreABecLap::solve (MultiFab& soln, const MultiFab& rhs, Real reltol, Real abst
     }
 
     HYPRE_StructPFMGSolve(solver, A, b, x);
+    ++m_num_solves_since_setup;
 
     if (verbose >= 2)
     {
@@ -179,13 +183,35 @@ HypreABecLap::prepareSolver ()
 
     HYPRE_StructStencilDestroy(stencil);
 
-    HYPRE_StructVectorCreate(comm, grid, &b);
-    HYPRE_StructVectorCreate(comm, grid, &x);
+    loadMatrix();
+    HYPRE_StructMatrixAssemble(A);
 
-    HYPRE_StructVectorInitialize(b);
-    HYPRE_StructVectorInitialize(x);
+    setupSolver();
+
+    m_coeffs_changed = false;
+}
+
+void
+HypreABecLap::updateMatrix ()
+{
+    BL_PROFILE("HypreABecLap::updateMatrix()");
+
+    // The grid and the stencil are kept.  Only the values are reset.
+    loadMatrix();
+    HYPRE_StructMatrixAssemble(A);
+
+    if (needSolverSetup()) {
+        setupSolver();
+    }
+
+    m_coeffs_changed = false;
+}
+
+void
+HypreABecLap::loadMatrix ()
+{
+    BL_PROFILE("HypreABecLap::loadMatrix()");
 
-    // A.SetValues() & A.assemble()
     Array<HYPRE_Int,regular_stencil_size> stencil_indices;
     std::iota(stencil_indices.begin(), stencil_indices.end(), 0);
     const auto dx = geom.CellSizeArray();
@@ -237,7 +263,23 @@ HypreABecLap::prepareSolver ()
                                        mat);
         Gpu::hypreSynchronize();
     }
-    HYPRE_StructMatrixAssemble(A);
+}
+
+void
+HypreABecLap::setupSolver ()
+{
+    BL_PROFILE("HypreABecLap::setupSolver()");
+
+    if (solver) {
+        HYPRE_StructPFMGDestroy(solver);
+        solver = nullptr;
+    }
+
+    HYPRE_StructVectorCreate(comm, grid, &b);
+    HYPRE_StructVectorCreate(comm, grid, &x);
+
+    HYPRE_StructVectorInitialize(b);
+    HYPRE_StructVectorInitialize(x);
 
     // create solver
     HYPRE_StructPFMGCreate(comm, &solver);
@@ -249,6 +291,8 @@ HypreABecLap::prepareSolver ()
     b = nullptr;
     HYPRE_StructVectorDestroy(x);
     x = nullptr;
+
+    m_num_solves_since_setup = 0;
 }
 
 
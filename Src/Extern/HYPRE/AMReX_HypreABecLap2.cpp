@@ -48,6 +48,9 @@ HypreABecLap2::solve (MultiFab& soln, const MultiFab& rhs, Real reltol, Real abs
     else
     {
         m_factory = &(rhs.Factory());
+        if (m_coeffs_changed) {
+            updateMatrix();
+        }
     }
 
     // We have to do this repeatedly to avoid memory leak due to Hypre bug
@@ -93,6 +96,7 @@ HypreABecLap2::solve (MultiFab& soln, const MultiFab& rhs, Real reltol, Real abs
     HYPRE_SStructVectorGetObject(x, (void**) &par_x);
 
     HYPRE_BoomerAMGSolve(solver, par_A, par_b, par_x);
+    ++m_num_solves_since_setup;
 
     if (verbose >= 2)
     {
@@ -211,7 +215,38 @@ HypreABecLap2::prepareSolver ()
     HYPRE_SStructMatrixSetObjectType(A, HYPRE_PARCSR);
     HYPRE_SStructMatrixInitialize(A);
 
-    // A.SetValues() & A.assemble()
+    loadMatrix();
+    HYPRE_SStructMatrixAssemble(A);
+
+    setupSolver();
+
+    m_coeffs_changed = false;
+}
+
+void
+HypreABecLap2::updateMatrix ()
+{
+    BL_PROFILE("HypreABecLap2::updateMatrix()");
+
+    // The grid, the stencil, the graph and the matrix are kept.  Only the
+    // values are reset, so that the ParCSR matrix given to BoomerAMG in the
+    // last setup stays valid when the setup is reused.
+    loadMatrix();
+    HYPRE_SStructMatrixAssemble(A);
+
+    if (needSolverSetup()) {
+        setupSolver();
+    }
+
+    m_coeffs_changed = false;
+}
+
+void
+HypreABecLap2::loadMatrix ()
+{
+    BL_PROFILE("HypreABecLap2::loadMatrix()");
+
+    // A.SetValues()
     Array<HYPRE_Int,regular_stencil_size> stencil_indices;
     std::iota(stencil_indices.begin(), stencil_indices.end(), 0);
     const HYPRE_Int part = 0;
@@ -264,7 +299,17 @@ HypreABecLap2::prepareSolver ()
                                         mat);
         Gpu::hypreSynchronize();
     }
-    HYPRE_SStructMatrixAssemble(A);
+}
+
+void
+HypreABecLap2::setupSolver ()
+{
+    BL_PROFILE("HypreABecLap2::setupSolver()");
+
+    if (solver) {
+        HYPRE_BoomerAMGDestroy(solver);
+        solver = nullptr;
+    }
 
     // create solver
     HYPRE_BoomerAMGCreate(&solver);
@@ -283,6 +328,8 @@ HypreABecLap2::prepareSolver ()
     HYPRE_ParCSRMatrix par_A;
     HYPRE_SStructMatrixGetObject(A, (void**) &par_A);
     HYPRE_BoomerAMGSetup(solver, par_A, nullptr, nullptr);
+
+    m_num_solves_since_setup = 0;
 }
 
 void
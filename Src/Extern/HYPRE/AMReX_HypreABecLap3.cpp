@@ -42,6 +42,9 @@ HypreABecLap3::solve (MultiFab& soln, const MultiFab& rhs, Real rel_tol, Real ab
     else
     {
         m_factory = &(rhs.Factory());
+        if (m_coeffs_changed) {
+            updateMatrix();
+        }
     }
 
     HYPRE_IJVectorInitialize(b);
@@ -119,13 +122,6 @@ HypreABecLap3::prepareSolver ()
     AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_overset_mask == nullptr || ebfactory == nullptr,
                                      "Cannot have both EB and overset");
     const FabArray<EBCellFlagFab>* flags = (ebfactory) ? &(ebfactory->getMultiEBCellFlagFab()) : nullptr;
-    const MultiFab* vfrac = (ebfactory) ? &(ebfactory->getVolFrac()) : nullptr;
-    auto area = (ebfactory) ? ebfactory->getAreaFrac()
-        : Array<const MultiCutFab*,AMREX_SPACEDIM>{AMREX_D_DECL(nullptr,nullptr,nullptr)};
-    auto fcent = (ebfactory) ? ebfactory->getFaceCent()
-        : Array<const MultiCutFab*,AMREX_SPACEDIM>{AMREX_D_DECL(nullptr,nullptr,nullptr)};
-    auto const* barea = (ebfactory) ? &(ebfactory->getBndryArea()) : nullptr;
-    auto const* bcent = (ebfactory) ? &(ebfactory->getBndryCent()) : nullptr;
 
     if (ebfactory)
     {
@@ -315,12 +311,62 @@ HypreABecLap3::prepareSolver ()
     b = hypre_ij->b();
     x = hypre_ij->x();
 
+    loadMatrix(false);
+
+    m_coeffs_changed = false;
+}
+
+void
+HypreABecLap3::updateMatrix ()
+{
+    BL_PROFILE("HypreABecLap3::updateMatrix()");
+
+    // The cell ids, the row partitioning and the sparsity pattern are kept,
+    // and only the matrix values are updated.  If an entry that was zero
+    // has become nonzero, the sparsity pattern has changed and we have to
+    // start over.
+    if (loadMatrix(true)) {
+        hypre_ij->matrixValuesUpdated();
+        m_coeffs_changed = false;
+    } else {
+        prepareSolver();
+    }
+}
+
+bool
+HypreABecLap3::loadMatrix (bool reuse_pattern)
+{
+    BL_PROFILE("HypreABecLap3::loadMatrix()");
+
+    const BoxArray& ba = acoefs.boxArray();
+    const DistributionMapping& dm = acoefs.DistributionMap();
+
+#ifdef AMREX_USE_EB
+    auto const* ebfactory = dynamic_cast<EBFArrayBoxFactory const*>(m_factory);
+    const FabArray<EBCellFlagFab>* flags = (ebfactory) ? &(ebfactory->getMultiEBCellFlagFab()) : nullptr;
+    const MultiFab* vfrac = (ebfactory) ? &(ebfactory->getVolFrac()) : nullptr;
+    auto area = (ebfactory) ? ebfactory->getAreaFrac()
+        : Array<const MultiCutFab*,AMREX_SPACEDIM>{AMREX_D_DECL(nullptr,nullptr,nullptr)};
+    auto fcent = (ebfactory) ? ebfactory->getFaceCent()
+        : Array<const MultiCutFab*,AMREX_SPACEDIM>{AMREX_D_DECL(nullptr,nullptr,nullptr)};
+    auto const* barea = (ebfactory) ? &(ebfactory->getBndryArea()) : nullptr;
+    auto const* bcent = (ebfactory) ? &(ebfactory->getBndryCent()) : nullptr;
+#endif
+
+    if (!reuse_pattern) {
+        m_ncols.define(ba,dm);
+        m_cols.define(ba,dm);
+        m_keep.define(ba,dm);
+    }
+    LayoutData<Gpu::DeviceVector<Real> > mat_vec(ba,dm);
+    bool same_pattern = true;
+
     const auto dx = geom.CellSizeArray();
     const int bho = (m_maxorder > 2) ? 1 : 0;
     BaseFab<HYPRE_Int> ncols_fab;
 
-    BaseFab<Real> mat_aos_fab, mat_vec_fab;
-    BaseFab<HYPRE_Int> cols_aos_fab, cols_vec_fab;
+    BaseFab<Real> mat_aos_fab;
+    BaseFab<HYPRE_Int> cols_aos_fab;
 
     for (MFIter mfi(acoefs); mfi.isValid(); ++mfi)
     {
@@ -436,10 +482,8 @@ HypreABecLap3::prepareSolver ()
 
             const HYPRE_Int nrows = ncells_grid[mfi];
             AMREX_ASSERT(nrows == static_cast<HYPRE_Int>(bx.numPts()));
-            HYPRE_Int* rows = cell_id_vec[mfi].dataPtr();
-            HYPRE_Int* ncols = ncols_fab.dataPtr();
+            HYPRE_Int const* rows = cell_id_vec[mfi].dataPtr();
 
-            // Remove invalid elements
 #if defined(AMREX_DEBUG) || defined(AMREX_TESTING)
             if (sizeof(HYPRE_Int) < sizeof(Long)) {
                 Long ntot = static_cast<Long>(nrows)*max_stencil_size;
@@ -450,43 +494,54 @@ HypreABecLap3::prepareSolver ()
             HYPRE_Int nelems = nrows * max_stencil_size;
             HYPRE_Int const* cols_in = cols_aos_fab.dataPtr();
             Real const* mat_in = mat_aos_fab.dataPtr();
-            HYPRE_Int* cols;
-            Real* mat;
-#ifdef AMREX_USE_GPU
-            if (Gpu::inLaunchRegion()) {
-                cols_vec_fab.resize(bx,max_stencil_size);
-                mat_vec_fab.resize(bx,max_stencil_size);
-                cols = cols_vec_fab.dataPtr();
-                mat = mat_vec_fab.dataPtr();
-                Scan::PrefixSum<HYPRE_Int>(nelems,
-                    [=] AMREX_GPU_DEVICE (HYPRE_Int i) -> HYPRE_Int { return (mat_in[i] != Real(0.0)); },
-                    [=] AMREX_GPU_DEVICE (HYPRE_Int i, HYPRE_Int const& x) {
-                        if (mat_in[i] != Real(0.0)) {
-                            cols[x] = cols_in[i];
-                            mat[x] = mat_in[i];
-                        }
-                    }, Scan::Type::exclusive);
-            } else
-#endif
-            {
-                cols = const_cast<HYPRE_Int*>(cols_in);
-                mat = const_cast<Real*>(mat_in);
-                HYPRE_Int m = 0;
-                for (HYPRE_Int ielem = 0; ielem < nelems; ++ielem) {
-                    if (mat_in[ielem] != Real(0.0)) {
-                        if (m != ielem) {
-                            cols[m] = cols_in[ielem];
-                            mat[m] = mat_in[ielem];
-                        }
-                        ++m;
-                    }
-                }
+
+            // Remove invalid elements.  The nonzero elements of the first
+            // matrix define the sparsity pattern used by later updates.
+            auto& keep_vec = m_keep[mfi];
+            if (!reuse_pattern) {
+                keep_vec.resize(nelems);
+                auto* keep = keep_vec.data();
+                amrex::ParallelFor(nelems, [=] AMREX_GPU_DEVICE (HYPRE_Int i) noexcept
+                {
+                    keep[i] = (mat_in[i] != Real(0.0));
+                });
+                m_ncols[mfi].resize(nrows);
+                Gpu::copyAsync(Gpu::deviceToDevice, ncols_fab.dataPtr(),
+                               ncols_fab.dataPtr()+nrows, m_ncols[mfi].begin());
+            } else {
+                auto const* keep = keep_vec.data();
+                auto nnew = Reduce::Sum<HYPRE_Int>(nelems,
+                    [=] AMREX_GPU_DEVICE (HYPRE_Int i) -> HYPRE_Int
+                    {
+                        return (mat_in[i] != Real(0.0)) && !keep[i];
+                    });
+                if (nnew > 0) { same_pattern = false; }
             }
 
+            auto const* keep = keep_vec.data();
+            auto& cols_vec = m_cols[mfi];
+            auto& mat_v = mat_vec[mfi];
+            mat_v.resize(nelems);
+            if (!reuse_pattern) { cols_vec.resize(nelems); }
+            HYPRE_Int* cols = cols_vec.data();
+            Real* mat = mat_v.data();
+            const bool fill_cols = !reuse_pattern;
+            HYPRE_Int nnz = Scan::PrefixSum<HYPRE_Int>(nelems,
+                [=] AMREX_GPU_DEVICE (HYPRE_Int i) -> HYPRE_Int { return keep[i]; },
+                [=] AMREX_GPU_DEVICE (HYPRE_Int i, HYPRE_Int const& x) {
+                    if (keep[i]) {
+                        if (fill_cols) { cols[x] = cols_in[i]; }
+                        mat[x] = mat_in[i];
+                    }
+                }, Scan::Type::exclusive);
+            mat_v.resize(nnz);
+            if (fill_cols) { cols_vec.resize(nnz); }
+
             // For singular matrices set reference solution on one row
             if (hypre_ij->adjustSingularMatrix() && is_matrix_singular) {
                 AMREX_ASSERT_WITH_MESSAGE(fabtyp == FabType::regular,
                                           "adjustSingularMatrix not supported for EB");
+                HYPRE_Int const* ncols = m_ncols[mfi].data();
                 AMREX_HOST_DEVICE_FOR_1D(1, m,
                 {
                     amrex::ignore_unused(m);
@@ -498,13 +553,29 @@ HypreABecLap3::prepareSolver ()
                     }
                 });
             }
+        }
+    }
 
-            Gpu::streamSynchronize();
-            HYPRE_IJMatrixSetValues(A,nrows,ncols,rows,cols,mat);
-            Gpu::hypreSynchronize();
+    if (reuse_pattern) {
+        ParallelAllReduce::And(same_pattern, comm);
+        if (!same_pattern) { return false; }
+        // Re-initializing an assembled matrix keeps its structure
+        HYPRE_IJMatrixInitialize(A);
+    }
+
+    Gpu::streamSynchronize();
+    for (MFIter mfi(acoefs); mfi.isValid(); ++mfi)
+    {
+        const HYPRE_Int nrows = ncells_grid[mfi];
+        if (nrows > 0) {
+            HYPRE_IJMatrixSetValues(A, nrows, m_ncols[mfi].data(), cell_id_vec[mfi].dataPtr(),
+                                    m_cols[mfi].data(), mat_vec[mfi].data());
         }
     }
+    Gpu::hypreSynchronize();
     HYPRE_IJMatrixAssemble(A);
+
+    return true;
 }
 
 void
@@ -100,7 +100,18 @@ HypreIJIface::~HypreIJIface ()
 
 void HypreIJIface::run_hypre_setup ()
 {
-    if (m_need_setup || m_recompute_preconditioner) {
+    bool do_setup = m_need_setup;
+    if (!do_setup) {
+        if (m_max_setup_reuse > 0) {
+            // The setup is still exact if the matrix has not changed.
+            do_setup = m_matrix_updated
+                && (m_num_solves_since_setup >= m_max_setup_reuse);
+        } else {
+            do_setup = m_recompute_preconditioner;
+        }
+    }
+
+    if (do_setup) {
         BL_PROFILE("HypreIJIface::run_hypre_setup()");
         if (m_has_preconditioner) {
             m_solverPrecondPtr(
@@ -109,6 +120,8 @@ void HypreIJIface::run_hypre_setup ()
 
         m_solverSetupPtr(m_solver, m_parA, m_parRhs, m_parSln);
         m_need_setup = false;
+        m_matrix_updated = false;
+        m_num_solves_since_setup = 0;
     }
 }
 
@@ -116,6 +129,7 @@ void HypreIJIface::run_hypre_solve ()
 {
     BL_PROFILE("HypreIJIface::run_hypre_solve()");
     m_solverSolvePtr(m_solver, m_parA, m_parRhs, m_parSln);
+    ++m_num_solves_since_setup;
 }
 
 void HypreIJIface::solve (
@@ -176,6 +190,7 @@ void HypreIJIface::parse_inputs (const std::string& prefix)
     pp.queryAdd("hypre_solver", m_solver_name);
     pp.queryAdd("hypre_preconditioner", m_preconditioner_name);
     pp.queryAdd("recompute_preconditioner", m_recompute_preconditioner);
+    pp.queryAdd("max_setup_reuse", m_max_setup_reuse);
     pp.queryAdd("write_matrix_files", m_write_files);
     pp.queryAdd("overwrite_existing_matrix_files", m_overwrite_files);
     pp.queryAdd("adjust_singular_matrix", m_adjust_singular_matrix);
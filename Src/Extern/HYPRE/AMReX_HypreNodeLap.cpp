@@ -87,6 +87,29 @@ HypreNodeLap::HypreNodeLap (const BoxArray& grids_, const DistributionMapping& d
     b = hypre_ij->b();
     x = hypre_ij->x();
 
+    loadMatrix();
+}
+
+HypreNodeLap::~HypreNodeLap () = default;
+
+void
+HypreNodeLap::updateMatrix ()
+{
+    BL_PROFILE("HypreNodeLap::updateMatrix()");
+
+    // The node ids and the sparsity pattern do not depend on the
+    // coefficients.  Re-initializing the assembled matrix keeps its
+    // structure, and only the values are reset.
+    HYPRE_IJMatrixInitialize(A);
+    loadMatrix();
+    hypre_ij->matrixValuesUpdated();
+}
+
+void
+HypreNodeLap::loadMatrix ()
+{
+    BL_PROFILE("HypreNodeLap::loadMatrix()");
+
     Gpu::DeviceVector<Int> ncols_vec;
     Gpu::DeviceVector<Int> cols_vec;
     Gpu::DeviceVector<Real> mat_vec;
@@ -131,8 +154,6 @@ HypreNodeLap::HypreNodeLap (const BoxArray& grids_, const DistributionMapping& d
     HYPRE_IJMatrixAssemble(A);
 }
 
-HypreNodeLap::~HypreNodeLap () = default;
-
 void
 HypreNodeLap::solve (MultiFab& soln, const MultiFab& rhs,
                      Real rel_tol, Real abs_tol, int max_iter)
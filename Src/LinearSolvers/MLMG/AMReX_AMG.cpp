@@ -0,0 +1,673 @@
+
+#include <AMReX_AMG.H>
+#include <AMReX_BiCGStab.H>
+#include <AMReX_BLassert.H>
+#include <AMReX_BLProfiler.H>
+#include <AMReX_OpenMP.H>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+namespace amrex {
+
+namespace {
+
+    // Coarsest levels larger than this and the max coarse size are solved
+    // by smoothing instead of dense LU.  This only happens if the coarsening
+    // stagnates.
+    constexpr int max_dense_size = 2000;
+
+    Vector<Real> get_diagonal (AMG::CSR const& A)
+    {
+        Vector<Real> d(A.nrows, Real(0.0));
+        for (int i = 0; i < A.nrows; ++i) {
+            for (int k = A.rowptr[i]; k < A.rowptr[i+1]; ++k) {
+                if (A.colidx[k] == i) { d[i] += A.val[k]; }
+            }
+        }
+        return d;
+    }
+
+    Real dot (int n, Real const* AMREX_RESTRICT x, Real const* AMREX_RESTRICT y)
+    {
+        Real r = Real(0.0);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for reduction(+:r)
+#endif
+        for (int i = 0; i < n; ++i) {
+            r += x[i]*y[i];
+        }
+        return r;
+    }
+
+    Real norm_inf (int n, Real const* AMREX_RESTRICT x)
+    {
+        Real r = Real(0.0);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for reduction(max:r)
+#endif
+        for (int i = 0; i < n; ++i) {
+            r = std::max(r, std::abs(x[i]));
+        }
+        return r;
+    }
+
+    //! y += a*x
+    void saxpy (int n, Real* AMREX_RESTRICT y, Real a, Real const* AMREX_RESTRICT x)
+    {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for
+#endif
+        for (int i = 0; i < n; ++i) {
+            y[i] += a*x[i];
+        }
+    }
+
+    //! The AMG preconditioned operator for BiCGStab
+    struct AMGOp
+    {
+        using RT = Real;
+
+        AMG& amg;
+        AMG::CSR const& A;
+
+        [[nodiscard]] Vector<Real> makeVecRHS () const { return Vector<Real>(A.nrows); }
+        [[nodiscard]] Vector<Real> makeVecLHS () const { return Vector<Real>(A.nrows); }
+
+        void apply (Vector<Real>& lhs, Vector<Real> const& rhs) const {
+            AMG::matvec(A, rhs.data(), lhs.data());
+        }
+        void precond (Vector<Real>& lhs, Vector<Real> const& rhs) const {
+            amg.vcycle(lhs.data(), rhs.data());
+        }
+        static void assign (Vector<Real>& lhs, Vector<Real> const& rhs) {
+            std::copy(rhs.begin(), rhs.end(), lhs.begin());
+        }
+        static void setToZero (Vector<Real>& v) {
+            std::fill(v.begin(), v.end(), Real(0.0));
+        }
+        static void increment (Vector<Real>& lhs, Vector<Real> const& rhs, Real a) {
+            saxpy(static_cast<int>(lhs.size()), lhs.data(), a, rhs.data());
+        }
+        static void linComb (Vector<Real>& lhs, Real a, Vector<Real> const& rhs_a,
+                             Real b, Vector<Real> const& rhs_b)
+        {
+            auto const n = static_cast<int>(lhs.size());
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for
+#endif
+            for (int i = 0; i < n; ++i) {
+                lhs[i] = a*rhs_a[i] + b*rhs_b[i];
+            }
+        }
+        static Real dotProduct (Vector<Real> const& v1, Vector<Real> const& v2) {
+            return dot(static_cast<int>(v1.size()), v1.data(), v2.data());
+        }
+        static Real norminf (Vector<Real> const& v) {
+            return norm_inf(static_cast<int>(v.size()), v.data());
+        }
+    };
+
+    bool is_strong (Real aij, Real aii, Real ajj, Real theta)
+    {
+        return std::abs(aij) >= theta * std::sqrt(std::abs(aii*ajj));
+    }
+}
+
+void
+AMG::define (CSR&& a_A)
+{
+    BL_PROFILE("AMG::define()");
+
+    AMREX_ALWAYS_ASSERT(a_A.nrows == a_A.ncols &&
+                        static_cast<int>(a_A.rowptr.size()) == a_A.nrows+1);
+
+    m_levels.clear();
+    m_levels.emplace_back();
+    m_levels[0].A = std::move(a_A);
+
+    while (static_cast<int>(m_levels.size()) < m_max_levels)
+    {
+        auto& fine = m_levels.back();
+        int const n = fine.A.nrows;
+        if (n <= m_max_coarse_size) { break; }
+
+        Vector<int> agg;
+        int const nagg = aggregate(fine.A, agg);
+        if (nagg == 0 || nagg >= n) { break; } // coarsening has stagnated
+
+        fine.P = smoothedProlongation(fine.A, agg, nagg);
+        fine.R = transpose(fine.P);
+        CSR Ac = matmul(fine.R, matmul(fine.A, fine.P));
+
+        m_levels.emplace_back();
+        m_levels.back().A = std::move(Ac);
+    }
+
+    for (auto& lev : m_levels) {
+        int const n = lev.A.nrows;
+        auto const diag = get_diagonal(lev.A);
+        lev.dinv.resize(n);
+        for (int i = 0; i < n; ++i) {
+            lev.dinv[i] = (diag[i] != Real(0.0)) ? Real(1.0)/diag[i] : Real(0.0);
+        }
+        lev.x.resize(n);
+        lev.b.resize(n);
+        lev.r.resize(n);
+    }
+
+    factorCoarsest();
+}
+
+Real
+AMG::operatorComplexity () const noexcept
+{
+    if (m_levels.empty() || m_levels[0].A.nnz() == 0) { return Real(0.0); }
+    Long nnz = 0;
+    for (auto const& lev : m_levels) {
+        nnz += lev.A.nnz();
+    }
+    return static_cast<Real>(nnz) / static_cast<Real>(m_levels[0].A.nnz());
+}
+
+int
+AMG::aggregate (CSR const& A, Vector<int>& agg) const
+{
+    int const n = A.nrows;
+    auto const diag = get_diagonal(A);
+
+    // Strong connections
+    Vector<int> sptr(n+1, 0);
+    Vector<int> scol;
+    scol.reserve(A.nnz());
+    for (int i = 0; i < n; ++i) {
+        for (int k = A.rowptr[i]; k < A.rowptr[i+1]; ++k) {
+            int const j = A.colidx[k];
+            if (j != i && is_strong(A.val[k], diag[i], diag[j], m_theta)) {
+                scol.push_back(j);
+            }
+        }
+        sptr[i+1] = static_cast<int>(scol.size());
+    }
+
+    agg.assign(n, -1);
+    int nagg = 0;
+
+    // Phase 1: a row whose strong neighbors are all free forms an
+    // aggregate with them.
+    for (int i = 0; i < n; ++i) {
+        if (agg[i] >= 0 || sptr[i] == sptr[i+1]) { continue; }
+        bool all_free = true;
+        for (int k = sptr[i]; k < sptr[i+1] && all_free; ++k) {
+            all_free = agg[scol[k]] < 0;
+        }
+        if (all_free) {
+            agg[i] = nagg;
+            for (int k = sptr[i]; k < sptr[i+1]; ++k) {
+                agg[scol[k]] = nagg;
+            }
+            ++nagg;
+        }
+    }
+
+    // Phase 2: the remaining rows join an aggregate of a strong neighbor.
+    Vector<int> agg2 = agg;
+    for (int i = 0; i < n; ++i) {
+        if (agg[i] >= 0) { continue; }
+        for (int k = sptr[i]; k < sptr[i+1]; ++k) {
+            if (agg[scol[k]] >= 0) {
+                agg2[i] = agg[scol[k]];
+                break;
+            }
+        }
+    }
+    agg = std::move(agg2);
+
+    // Phase 3: what is left forms new aggregates with its free strong
+    // neighbors.  Rows without strong connections are not aggregated.
+    for (int i = 0; i < n; ++i) {
+        if (agg[i] >= 0 || sptr[i] == sptr[i+1]) { continue; }
+        agg[i] = nagg;
+        for (int k = sptr[i]; k < sptr[i+1]; ++k) {
+            if (agg[scol[k]] < 0) { agg[scol[k]] = nagg; }
+        }
+        ++nagg;
+    }
+
+    return nagg;
+}
+
+AMG::CSR
+AMG::smoothedProlongation (CSR const& A, Vector<int> const& agg, int nagg) const
+{
+    int const n = A.nrows;
+    auto const diag = get_diagonal(A);
+
+    // Diagonal of the filtered matrix, into which the weak connections
+    // are lumped, and the Gershgorin bound of the spectral radius of
+    // D^{-1} A for the filtered matrix.
+    Vector<Real> dfilt(n);
+    Real rho = Real(0.0);
+    for (int i = 0; i < n; ++i) {
+        Real d = diag[i];
+        Real offsum = Real(0.0);
+        for (int k = A.rowptr[i]; k < A.rowptr[i+1]; ++k) {
+            int const j = A.colidx[k];
+            if (j == i) { continue; }
+            if (is_strong(A.val[k], diag[i], diag[j], m_theta)) {
+                offsum += std::abs(A.val[k]);
+            } else {
+                d += A.val[k];
+            }
+        }
+        dfilt[i] = d;
+        if (d != Real(0.0)) {
+            rho = std::max(rho, (std::abs(d)+offsum)/std::abs(d));
+        }
+    }
+    Real const omega = (rho > Real(0.0)) ? Real(4.0/3.0)/rho : Real(0.0);
+
+    // P = (I - omega D_F^{-1} A_F) T
+    CSR P;
+    P.nrows = n;
+    P.ncols = nagg;
+    P.rowptr.resize(n+1);
+    P.rowptr[0] = 0;
+    P.colidx.reserve(A.nnz());
+    P.val.reserve(A.nnz());
+
+    Vector<int> marker(nagg, -1);
+    Vector<int> pos(nagg);
+    for (int i = 0; i < n; ++i) {
+        auto add = [&] (int c, Real v) {
+            if (marker[c] != i) {
+                marker[c] = i;
+                pos[c] = static_cast<int>(P.colidx.size());
+                P.colidx.push_back(c);
+                P.val.push_back(v);
+            } else {
+                P.val[pos[c]] += v;
+            }
+        };
+        if (agg[i] >= 0) {
+            add(agg[i], Real(1.0));
+        }
+        if (dfilt[i] != Real(0.0)) {
+            Real const s = omega/dfilt[i];
+            if (agg[i] >= 0) {
+                add(agg[i], -s*dfilt[i]);
+            }
+            for (int k = A.rowptr[i]; k < A.rowptr[i+1]; ++k) {
+                int const j = A.colidx[k];
+                if (j != i && agg[j] >= 0 &&
+                    is_strong(A.val[k], diag[i], diag[j], m_theta))
+                {
+                    add(agg[j], -s*A.val[k]);
+                }
+            }
+        }
+        P.rowptr[i+1] = static_cast<int>(P.colidx.size());
+    }
+
+    return P;
+}
+
+void
+AMG::matvec (CSR const& A, Real const* AMREX_RESTRICT x, Real* AMREX_RESTRICT y)
+{
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < A.nrows; ++i) {
+        Real s = Real(0.0);
+        for (int k = A.rowptr[i]; k < A.rowptr[i+1]; ++k) {
+            s += A.val[k] * x[A.colidx[k]];
+        }
+        y[i] = s;
+    }
+}
+
+AMG::CSR
+AMG::transpose (CSR const& A)
+{
+    CSR T;
+    T.nrows = A.ncols;
+    T.ncols = A.nrows;
+    T.rowptr.assign(T.nrows+1, 0);
+    for (int k = 0; k < A.nnz(); ++k) {
+        ++T.rowptr[A.colidx[k]+1];
+    }
+    std::partial_sum(T.rowptr.begin(), T.rowptr.end(), T.rowptr.begin());
+    T.colidx.resize(A.nnz());
+    T.val.resize(A.nnz());
+    Vector<int> next(T.rowptr.begin(), T.rowptr.end()-1);
+    for (int i = 0; i < A.nrows; ++i) {
+        for (int k = A.rowptr[i]; k < A.rowptr[i+1]; ++k) {
+            int const p = next[A.colidx[k]]++;
+            T.colidx[p] = i;
+            T.val[p] = A.val[k];
+        }
+    }
+    return T;
+}
+
+AMG::CSR
+AMG::matmul (CSR const& A, CSR const& B)
+{
+    BL_PROFILE("AMG::matmul()");
+
+    AMREX_ASSERT(A.ncols == B.nrows);
+
+    CSR C;
+    C.nrows = A.nrows;
+    C.ncols = B.ncols;
+    C.rowptr.resize(A.nrows+1);
+    C.rowptr[0] = 0;
+
+    // Count the nonzeros in each row
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+    {
+        Vector<int> marker(B.ncols, -1);
+#ifdef AMREX_USE_OMP
+#pragma omp for
+#endif
+        for (int i = 0; i < A.nrows; ++i) {
+            int cnt = 0;
+            for (int ka = A.rowptr[i]; ka < A.rowptr[i+1]; ++ka) {
+                int const j = A.colidx[ka];
+                for (int kb = B.rowptr[j]; kb < B.rowptr[j+1]; ++kb) {
+                    int const c = B.colidx[kb];
+                    if (marker[c] != i) {
+                        marker[c] = i;
+                        ++cnt;
+                    }
+                }
+            }
+            C.rowptr[i+1] = cnt;
+        }
+    }
+
+    std::partial_sum(C.rowptr.begin(), C.rowptr.end(), C.rowptr.begin());
+    C.colidx.resize(C.nnz());
+    C.val.resize(C.nnz());
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+    {
+        Vector<int> marker(B.ncols, -1);
+        Vector<int> pos(B.ncols);
+#ifdef AMREX_USE_OMP
+#pragma omp for
+#endif
+        for (int i = 0; i < A.nrows; ++i) {
+            int p = C.rowptr[i];
+            for (int ka = A.rowptr[i]; ka < A.rowptr[i+1]; ++ka) {
+                int const j = A.colidx[ka];
+                Real const a = A.val[ka];
+                for (int kb = B.rowptr[j]; kb < B.rowptr[j+1]; ++kb) {
+                    int const c = B.colidx[kb];
+                    if (marker[c] != i) {
+                        marker[c] = i;
+                        pos[c] = p;
+                        C.colidx[p] = c;
+                        C.val[p] = a * B.val[kb];
+                        ++p;
+                    } else {
+                        C.val[pos[c]] += a * B.val[kb];
+                    }
+                }
+            }
+        }
+    }
+
+    return C;
+}
+
+void
+AMG::relax (Level& lev, bool forward)
+{
+    auto const& A = lev.A;
+    int const n = A.nrows;
+    Real* AMREX_RESTRICT x = lev.x.data();
+    Real const* AMREX_RESTRICT b = lev.b.data();
+    Real const* AMREX_RESTRICT dinv = lev.dinv.data();
+    int const* AMREX_RESTRICT rowptr = A.rowptr.data();
+    int const* AMREX_RESTRICT colidx = A.colidx.data();
+    Real const* AMREX_RESTRICT val = A.val.data();
+
+    int const nthreads = (n >= 1024) ? OpenMP::get_max_threads() : 1;
+
+    if (nthreads == 1) {
+        auto update = [&] (int i)
+        {
+            Real s = b[i];
+            for (int k = rowptr[i]; k < rowptr[i+1]; ++k) {
+                s -= val[k] * x[colidx[k]];
+            }
+            x[i] += s * dinv[i];
+        };
+        if (forward) {
+            for (int i = 0; i < n; ++i) { update(i); }
+        } else {
+            for (int i = n-1; i >= 0; --i) { update(i); }
+        }
+        return;
+    }
+
+    // Rows owned by other threads use the values from before the sweep.
+    std::copy(lev.x.begin(), lev.x.end(), lev.r.begin());
+    Real const* AMREX_RESTRICT xold = lev.r.data();
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel num_threads(nthreads)
+#endif
+    {
+        int const nt = OpenMP::get_num_threads();
+        int const tid = OpenMP::get_thread_num();
+        int const ibegin = static_cast<int>((Long(n)*tid)/nt);
+        int const iend = static_cast<int>((Long(n)*(tid+1))/nt);
+        auto update = [&] (int i)
+        {
+            Real s = b[i];
+            for (int k = rowptr[i]; k < rowptr[i+1]; ++k) {
+                int const j = colidx[k];
+                s -= val[k] * ((j >= ibegin && j < iend) ? x[j] : xold[j]);
+            }
+            x[i] += s * dinv[i];
+        };
+        if (forward) {
+            for (int i = ibegin; i < iend; ++i) { update(i); }
+        } else {
+            for (int i = iend-1; i >= ibegin; --i) { update(i); }
+        }
+    }
+}
+
+void
+AMG::vcycle (Real* x, Real const* b)
+{
+    BL_PROFILE("AMG::vcycle()");
+
+    if (m_levels.empty()) { return; }
+
+    auto& lev = m_levels[0];
+    std::copy(b, b+lev.A.nrows, lev.b.begin());
+    vcycle(0);
+    std::copy(lev.x.begin(), lev.x.end(), x);
+}
+
+int
+AMG::solve (Real* x, Real const* b, Real eps_rel, Real eps_abs, int maxiter)
+{
+    BL_PROFILE("AMG::solve()");
+
+    AMGOp op{*this, m_levels[0].A};
+    BiCGStab<Vector<Real>,AMGOp> bicg(op);
+    bicg.setMaxIter(maxiter);
+
+    Vector<Real> xv(numRows());
+    Vector<Real> const bv(b, b+numRows());
+    int const ret = bicg.solve(xv, bv, eps_rel, eps_abs);
+    std::copy(xv.begin(), xv.end(), x);
+
+    m_num_iters = bicg.getNumIters();
+    m_rel_residual = bicg.getRelativeResidual();
+    return ret;
+}
+
+void
+AMG::vcycle (int ilev)
+{
+    auto& lev = m_levels[ilev];
+    int const n = lev.A.nrows;
+
+    if (ilev == numLevels()-1) {
+        if (n <= maxDenseSize()) {
+            solveCoarsest(lev.x.data(), lev.b.data());
+        } else {
+            std::fill(lev.x.begin(), lev.x.end(), Real(0.0));
+            for (int i = 0; i < 8*m_nsweeps; ++i) {
+                relax(lev, true);
+                relax(lev, false);
+            }
+        }
+        return;
+    }
+
+    std::fill(lev.x.begin(), lev.x.end(), Real(0.0));
+    for (int i = 0; i < m_nsweeps; ++i) {
+        relax(lev, true);
+    }
+
+    Real* AMREX_RESTRICT x = lev.x.data();
+    Real* AMREX_RESTRICT r = lev.r.data();
+    Real const* AMREX_RESTRICT b = lev.b.data();
+
+    matvec(lev.A, x, r);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < n; ++i) {
+        r[i] = b[i] - r[i];
+    }
+
+    auto& crse = m_levels[ilev+1];
+    matvec(lev.R, r, crse.b.data());
+
+    vcycle(ilev+1);
+
+    matvec(lev.P, crse.x.data(), r);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < n; ++i) {
+        x[i] += r[i];
+    }
+
+    for (int i = 0; i < m_nsweeps; ++i) {
+        relax(lev, false);
+    }
+}
+
+int
+AMG::maxDenseSize () const noexcept
+{
+    return std::max(max_dense_size, m_max_coarse_size);
+}
+
+void
+AMG::factorCoarsest ()
+{
+    BL_PROFILE("AMG::factorCoarsest()");
+
+    auto const& A = m_levels.back().A;
+    int const n = A.nrows;
+
+    m_lu.clear();
+    m_piv.clear();
+    m_zero_pivot.clear();
+    if (n > maxDenseSize()) { return; }
+
+    m_lu.assign(std::size_t(n)*n, Real(0.0));
+    m_piv.resize(n);
+    m_zero_pivot.assign(n, 0);
+
+    auto a = [&] (int i, int j) -> Real& { return m_lu[std::size_t(i)*n+j]; };
+
+    Real amax = Real(0.0);
+    for (int i = 0; i < n; ++i) {
+        for (int k = A.rowptr[i]; k < A.rowptr[i+1]; ++k) {
+            a(i,A.colidx[k]) += A.val[k];
+            amax = std::max(amax, std::abs(A.val[k]));
+        }
+    }
+
+    // LU with partial pivoting.  A singular matrix (e.g., pure Neumann
+    // problem) has (numerically) zero pivots.  The corresponding unknowns
+    // are set to zero in the solve.
+    Real const tiny = amax * Real(n) * std::numeric_limits<Real>::epsilon();
+    for (int k = 0; k < n; ++k) {
+        int p = k;
+        for (int i = k+1; i < n; ++i) {
+            if (std::abs(a(i,k)) > std::abs(a(p,k))) { p = i; }
+        }
+        m_piv[k] = p;
+        if (p != k) {
+            for (int j = 0; j < n; ++j) { std::swap(a(k,j), a(p,j)); }
+        }
+        if (std::abs(a(k,k)) <= tiny) {
+            m_zero_pivot[k] = 1;
+            a(k,k) = Real(1.0);
+            for (int j = k+1; j < n; ++j) { a(k,j) = Real(0.0); }
+            for (int i = k+1; i < n; ++i) { a(i,k) = Real(0.0); }
+            continue;
+        }
+        Real const pinv = Real(1.0)/a(k,k);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for if (n-k > 256)
+#endif
+        for (int i = k+1; i < n; ++i) {
+            Real const l = a(i,k) * pinv;
+            a(i,k) = l;
+            if (l != Real(0.0)) {
+                for (int j = k+1; j < n; ++j) {
+                    a(i,j) -= l * a(k,j);
+                }
+            }
+        }
+    }
+}
+
+void
+AMG::solveCoarsest (Real* x, Real const* b) const
+{
+    int const n = static_cast<int>(m_piv.size());
+    auto a = [&] (int i, int j) -> Real { return m_lu[std::size_t(i)*n+j]; };
+
+    std::copy(b, b+n, x);
+    for (int k = 0; k < n; ++k) {
+        if (m_piv[k] != k) { std::swap(x[k], x[m_piv[k]]); }
+    }
+    for (int i = 0; i < n; ++i) {
+        if (m_zero_pivot[i]) {
+            x[i] = Real(0.0);
+        } else {
+            Real s = x[i];
+            for (int j = 0; j < i; ++j) { s -= a(i,j) * x[j]; }
+            x[i] = s;
+        }
+    }
+    for (int i = n-1; i >= 0; --i) {
+        Real s = x[i];
+        for (int j = i+1; j < n; ++j) { s -= a(i,j) * x[j]; }
+        x[i] = s / a(i,i);
+    }
+}
+
+}
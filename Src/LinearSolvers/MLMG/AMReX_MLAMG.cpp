@@ -0,0 +1,440 @@
+
+#include <AMReX_MLAMG.H>
+#include <AMReX_BiCGStab.H>
+#include <AMReX_iMultiFab.H>
+#include <AMReX_Loop.H>
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+
+namespace amrex {
+
+namespace {
+    // Calls f(iv, icell) for the cells of bx in the order of their offsets
+    // icell in the box.
+    template <typename F>
+    void for_each_cell (Box const& bx, F const& f)
+    {
+        const auto lo = amrex::lbound(bx);
+        const auto hi = amrex::ubound(bx);
+        Long icell = 0;
+        for (int k = lo.z; k <= hi.z; ++k) {
+        for (int j = lo.y; j <= hi.y; ++j) {
+        for (int i = lo.x; i <= hi.x; ++i) {
+            f(IntVect(AMREX_D_DECL(i,j,k)), icell++);
+        }}}
+    }
+}
+
+MLAMG::MLAMG (MLLinOpT<MultiFab>& a_lp)
+    : m_linop(a_lp), m_mglev(a_lp.NMGLevels(0)-1)
+{
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(a_lp.isCellCentered() && a_lp.getNComp() == 1,
+                                     "MLAMG only supports single component cell-centered operators");
+    if (Gpu::inLaunchRegion()) {
+        amrex::Abort("MLAMG is not supported on GPU");
+    }
+}
+
+void
+MLAMG::setup ()
+{
+    BL_PROFILE("MLAMG::setup()");
+
+    const auto setup_start_time = amrex::second();
+
+    using BCMode = MLLinOpT<MultiFab>::BCMode;
+    using StateMode = MLLinOpT<MultiFab>::StateMode;
+
+    const int amrlev = 0;
+    const int mglev = m_mglev;
+    const Geometry& geom = m_linop.Geom(amrlev, mglev);
+    const Box& domain = geom.Domain();
+    const auto is_periodic = geom.isPeriodic();
+
+    MultiFab x = m_linop.make(amrlev, mglev, IntVect(1));
+    MultiFab y = m_linop.make(amrlev, mglev, IntVect(0));
+    const BoxArray& ba = y.boxArray();
+    const DistributionMapping& dm = y.DistributionMap();
+
+    // Stencil entries of each row.  The offset (s_0,s_1,s_2) in {-1,0,1}^3
+    // is stored in component (s_0+1) + 3*(s_1+1) + 9*(s_2+1).
+    constexpr int nsten = AMREX_D_TERM(3,*3,*3);
+    constexpr int center = AMREX_D_TERM(1,+3,+9);
+    MultiFab sten(ba, dm, nsten, 0);
+    sten.setVal(0.0);
+
+    // In each direction, the cells are colored with i%3, except that the
+    // last n%3 cells of a periodic direction with n%3 != 0 have their own
+    // colors.  So the cells in a 3-cell window always have distinct colors.
+    // The colors are tabulated for the domain grown by one cell, with -1
+    // outside non-periodic boundaries.
+    IntVect ncolors(3);
+    Array<Vector<int>,AMREX_SPACEDIM> dcolor;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        const int n = domain.length(idim);
+        const int m = n - n%3;
+        if (is_periodic[idim] && n%3 != 0) {
+            ncolors[idim] = 3 + n%3;
+        }
+        dcolor[idim].resize(n+2);
+        for (int ii = -1; ii <= n; ++ii) {
+            int c;
+            if (is_periodic[idim]) {
+                const int iw = (ii+n) % n;
+                c = (iw < m) ? iw%3 : 3 + (iw-m);
+            } else {
+                c = (ii < 0 || ii >= n) ? -1 : ii%3;
+            }
+            dcolor[idim][ii+1] = c;
+        }
+    }
+
+    auto color = [&] (int i, int idim) -> int
+    {
+        return dcolor[idim][i-domain.smallEnd(idim)+1];
+    };
+
+    // Offset from cell i to the cell with color c in the 3-cell window
+    // centered at i. Returns 2 if there is none.  Offset 0 is tried first
+    // so that the diagonal is found even if the window wraps around a
+    // short periodic direction.
+    auto find_offset = [&] (int i, int idim, int c) -> int
+    {
+        if (color(i  ,idim) == c) { return  0; }
+        if (color(i-1,idim) == c) { return -1; }
+        if (color(i+1,idim) == c) { return  1; }
+        return 2;
+    };
+
+    const Box cbox(IntVect(0), ncolors-1);
+    const auto nprobes = static_cast<int>(cbox.numPts());
+    for (int iprobe = 0; iprobe < nprobes; ++iprobe)
+    {
+        const IntVect c = cbox.atOffset(iprobe);
+
+        x.setVal(0.0);
+        for (MFIter mfi(x); mfi.isValid(); ++mfi) {
+            auto const& xa = x.array(mfi);
+            for_each_cell(mfi.validbox(), [&] (IntVect const& iv, Long)
+            {
+                bool match = true;
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    match = match && (color(iv[idim],idim) == c[idim]);
+                }
+                if (match) { xa(iv) = 1.0; }
+            });
+        }
+
+        m_linop.apply(amrlev, mglev, y, x, BCMode::Homogeneous, StateMode::Correction);
+        m_linop.normalize(amrlev, mglev, y);
+
+        for (MFIter mfi(y); mfi.isValid(); ++mfi) {
+            auto const& ya = y.const_array(mfi);
+            auto const& sa = sten.array(mfi);
+            for_each_cell(mfi.validbox(), [&] (IntVect const& iv, Long)
+            {
+                const Real v = ya(iv);
+                if (v == 0.0) { return; }
+                int is = 0;
+                int stride = 1;
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    const int so = find_offset(iv[idim], idim, c[idim]);
+                    if (so == 2) { return; }
+                    is += (so+1)*stride;
+                    stride *= 3;
+                }
+                sa(iv,is) += v;
+            });
+        }
+    }
+
+    // If the problem is small enough, all the rows go to the owner of the
+    // first box so that no couplings are dropped.
+    m_gather = ba.numPts() <= m_gather_max_cells;
+    if (m_gather) {
+        m_row_dm = DistributionMapping(Vector<int>(ba.size(), dm[0]));
+        MultiFab gathered_sten(ba, m_row_dm, nsten, 0);
+        gathered_sten.ParallelCopy(sten, 0, 0, nsten);
+        sten = std::move(gathered_sten);
+    } else {
+        m_row_dm = dm;
+    }
+
+    // Global ids of the cells in the order of the boxes.  Rows with zero
+    // diagonal are excluded by giving them negative ids.
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(ba.numPts() < Long(std::numeric_limits<int>::max()),
+                                     "MLAMG: too many cells on the bottom level");
+    const int nboxes = static_cast<int>(ba.size());
+    Vector<Long> box_offset(nboxes+1, 0);
+    for (int ibox = 0; ibox < nboxes; ++ibox) {
+        box_offset[ibox+1] = box_offset[ibox] + ba[ibox].numPts();
+    }
+
+    m_local_offset.assign(nboxes, -1);
+    int nlocal = 0;
+    for (MFIter mfi(ba, m_row_dm); mfi.isValid(); ++mfi) {
+        m_local_offset[mfi.index()] = nlocal;
+        nlocal += static_cast<int>(mfi.validbox().numPts());
+    }
+
+    iMultiFab ids(ba, m_row_dm, 1, 1);
+    ids.setVal(-1);
+    for (MFIter mfi(ids); mfi.isValid(); ++mfi) {
+        auto const& ia = ids.array(mfi);
+        auto const& sa = sten.const_array(mfi);
+        const Long offset = box_offset[mfi.index()];
+        for_each_cell(mfi.validbox(), [&] (IntVect const& iv, Long icell)
+        {
+            if (sa(iv,center) != 0.0) {
+                ia(iv) = static_cast<int>(offset + icell);
+            }
+        });
+    }
+    ids.FillBoundary(geom.periodicity());
+
+    auto global_to_local = [&] (Long gid) -> int
+    {
+        auto it = std::upper_bound(box_offset.begin(), box_offset.end(), gid);
+        const auto ibox = static_cast<int>(it - box_offset.begin()) - 1;
+        const int loffset = m_local_offset[ibox];
+        return (loffset < 0) ? -1 : loffset + static_cast<int>(gid - box_offset[ibox]);
+    };
+
+    // Process local matrix.  The couplings to the cells on other processes
+    // are dropped.
+    AMG::CSR A;
+    A.nrows = nlocal;
+    A.ncols = nlocal;
+    A.rowptr.reserve(nlocal+1);
+    A.rowptr.push_back(0);
+    A.colidx.reserve(std::size_t(nlocal)*nsten);
+    A.val.reserve(std::size_t(nlocal)*nsten);
+    m_inactive_rows.clear();
+    for (MFIter mfi(sten); mfi.isValid(); ++mfi) {
+        auto const& ia = ids.const_array(mfi);
+        auto const& sa = sten.const_array(mfi);
+        const int loffset = m_local_offset[mfi.index()];
+        for_each_cell(mfi.validbox(), [&] (IntVect const& iv, Long icell)
+        {
+            const int row = loffset + static_cast<int>(icell);
+            if (ia(iv) < 0) {
+                m_inactive_rows.push_back(row);
+                A.colidx.push_back(row);
+                A.val.push_back(1.0);
+            } else {
+                for (int is = 0; is < nsten; ++is) {
+                    const Real v = sa(iv,is);
+                    if (v == 0.0) { continue; }
+                    const IntVect s(AMREX_D_DECL(is%3-1, (is/3)%3-1, is/9-1));
+                    const int gid = ia(iv+s);
+                    if (gid < 0) { continue; }
+                    const int col = global_to_local(gid);
+                    if (col < 0) { continue; }
+                    A.colidx.push_back(col);
+                    A.val.push_back(v);
+                }
+            }
+            A.rowptr.push_back(static_cast<int>(A.colidx.size()));
+        });
+    }
+
+    const auto probe_time = amrex::second() - setup_start_time;
+    m_amg.define(std::move(A));
+
+    m_xvec.resize(nlocal);
+    m_bvec.resize(nlocal);
+
+    if (m_verbose > 0) {
+        Real r[2] = {Real(m_amg.numLevels()), m_amg.operatorComplexity()};
+        ParallelAllReduce::Max(r, 2, m_linop.BottomCommunicator());
+        amrex::Print() << "MLAMG: setup with " << nprobes << " operator applications"
+                       << (m_gather ? " (gathered onto one process)" : "")
+                       << ", max number of AMG levels = " << int(r[0])
+                       << ", max operator complexity = " << r[1] << "\n"
+                       << "MLAMG: setup time = " << amrex::second() - setup_start_time
+                       << " (probing = " << probe_time << ")\n";
+    }
+
+    m_setup_done = true;
+}
+
+void
+MLAMG::copyToVector (MultiFab const& mf, Vector<Real>& v) const
+{
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        auto const& a = mf.const_array(mfi);
+        Real* AMREX_RESTRICT p = v.data() + m_local_offset[mfi.index()];
+        Long icell = 0;
+        amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k) noexcept
+        {
+            p[icell++] = a(i,j,k);
+        });
+    }
+    for (auto row : m_inactive_rows) {
+        v[row] = 0.0;
+    }
+}
+
+void
+MLAMG::copyFromVector (MultiFab& mf, Vector<Real> const& v) const
+{
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        auto const& a = mf.array(mfi);
+        Real const* AMREX_RESTRICT p = v.data() + m_local_offset[mfi.index()];
+        Long icell = 0;
+        amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k) noexcept
+        {
+            a(i,j,k) = p[icell++];
+        });
+    }
+}
+
+void
+MLAMG::precond (MultiFab& z, MultiFab const& r)
+{
+    BL_PROFILE("MLAMG::precond()");
+
+    copyToVector(r, m_bvec);
+
+    m_amg.vcycle(m_xvec.data(), m_bvec.data());
+
+    for (auto row : m_inactive_rows) {
+        m_xvec[row] = 0.0;
+    }
+    copyFromVector(z, m_xvec);
+}
+
+int
+MLAMG::solveGathered (MultiFab& a_sol, MultiFab const& a_rhs, Real eps_rel, Real eps_abs)
+{
+    BL_PROFILE("MLAMG::solveGathered()");
+
+    const int amrlev = 0;
+    const int mglev = m_mglev;
+
+    MultiFab r = m_linop.make(amrlev, mglev, IntVect(0));
+    MultiFab::Copy(r, a_rhs, 0, 0, 1, 0);
+    m_linop.normalize(amrlev, mglev, r);
+
+    MultiFab gathered(r.boxArray(), m_row_dm, 1, 0);
+    gathered.ParallelCopy(r);
+
+    // ret, number of iterations and relative residual
+    Real info[3] = {0.0, 0.0, 0.0};
+    const int root = m_row_dm[0];
+    if (ParallelDescriptor::MyProc() == root) {
+        copyToVector(gathered, m_bvec);
+        const int ret = m_amg.solve(m_xvec.data(), m_bvec.data(), eps_rel, eps_abs, m_maxiter);
+        for (auto row : m_inactive_rows) {
+            m_xvec[row] = 0.0;
+        }
+        copyFromVector(gathered, m_xvec);
+        info[0] = Real(ret);
+        info[1] = Real(m_amg.numIters());
+        info[2] = m_amg.relativeResidual();
+    }
+    ParallelDescriptor::Bcast(info, 3, ParallelContext::global_to_local_rank(root),
+                              m_linop.BottomCommunicator());
+
+    a_sol.setVal(0.0);
+    a_sol.ParallelCopy(gathered);
+
+    const int ret = static_cast<int>(info[0]);
+    m_iter = static_cast<int>(info[1]);
+
+    if (m_verbose > 0) {
+        amrex::Print() << "MLAMG: Final: Iteration " << std::setw(4) << m_iter
+                       << " rel. err. " << info[2] << '\n';
+        if (ret == 8 || ret == 9) {
+            amrex::Warning("MLAMG: failed to converge!");
+        }
+    }
+
+    return ret;
+}
+
+Real
+MLAMG::norm_inf (MultiFab const& mf) const
+{
+    Real result = mf.norminf(0, 1, IntVect(0), true);
+    ParallelAllReduce::Max(result, m_linop.BottomCommunicator());
+    return result;
+}
+
+//! The operator on the bottom MG level, right preconditioned by the AMG
+struct MLAMG::BiCGOp
+{
+    using RT = Real;
+    using BCMode = MLLinOpT<MultiFab>::BCMode;
+    using StateMode = MLLinOpT<MultiFab>::StateMode;
+
+    MLAMG& mlamg;
+    MLLinOpT<MultiFab>& linop;
+    int mglev;
+
+    [[nodiscard]] MultiFab makeVecRHS () const { return linop.make(0, mglev, IntVect(0)); }
+    [[nodiscard]] MultiFab makeVecLHS () const { return linop.make(0, mglev, IntVect(1)); }
+
+    void apply (MultiFab& lhs, MultiFab const& rhs) const {
+        linop.apply(0, mglev, lhs, const_cast<MultiFab&>(rhs),
+                    BCMode::Homogeneous, StateMode::Correction);
+        linop.normalize(0, mglev, lhs);
+    }
+    void precond (MultiFab& lhs, MultiFab const& rhs) const {
+        mlamg.precond(lhs, rhs);
+    }
+    static void assign (MultiFab& lhs, MultiFab const& rhs) {
+        MultiFab::Copy(lhs, rhs, 0, 0, 1, 0);
+    }
+    static void setToZero (MultiFab& v) { v.setVal(0.0); }
+    static void increment (MultiFab& lhs, MultiFab const& rhs, Real a) {
+        MultiFab::Saxpy(lhs, a, rhs, 0, 0, 1, 0);
+    }
+    static void linComb (MultiFab& lhs, Real a, MultiFab const& rhs_a,
+                         Real b, MultiFab const& rhs_b)
+    {
+        MultiFab::LinComb(lhs, a, rhs_a, 0, b, rhs_b, 0, 0, 1, 0);
+    }
+    [[nodiscard]] Real dotProduct (MultiFab const& v1, MultiFab const& v2) const {
+        return linop.xdoty(0, mglev, v1, v2, false);
+    }
+    void multiDotProduct (MultiFab const& v1, MultiFab const* v2, int n, Real* result) const {
+        for (int j = 0; j < n; ++j) {
+            result[j] = linop.xdoty(0, mglev, v1, v2[j], true);
+        }
+        ParallelAllReduce::Sum(result, n, linop.BottomCommunicator());
+    }
+    [[nodiscard]] Real norminf (MultiFab const& v) const { return mlamg.norm_inf(v); }
+};
+
+int
+MLAMG::solve (MultiFab& a_sol, MultiFab const& a_rhs, Real eps_rel, Real eps_abs)
+{
+    BL_PROFILE("MLAMG::solve()");
+
+    if (!m_setup_done) { setup(); }
+
+    if (m_gather) { return solveGathered(a_sol, a_rhs, eps_rel, eps_abs); }
+
+    MultiFab r = m_linop.make(0, m_mglev, IntVect(0));
+    MultiFab::Copy(r, a_rhs, 0, 0, 1, 0);
+    m_linop.normalize(0, m_mglev, r);
+
+    BiCGOp op{*this, m_linop, m_mglev};
+    BiCGStab<MultiFab,BiCGOp> bicg(op);
+    bicg.setVerbose(m_verbose);
+    bicg.setMaxIter(m_maxiter);
+    bicg.setName("MLAMG");
+    const int ret = bicg.solve(a_sol, r, eps_rel, eps_abs);
+    m_iter = bicg.getNumIters();
+
+    if (m_verbose > 0 && (ret == 8 || ret == 9)) {
+        amrex::Warning("MLAMG: failed to converge!");
+    }
+
+    return ret;
+}
+
+}
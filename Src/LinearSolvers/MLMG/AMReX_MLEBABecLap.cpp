@@ -1310,6 +1310,15 @@ MLEBABecLap::makeHypre (Hypre::Interface hypre_interface) const
     ijmatrix_solver->setEBDirichlet(m_eb_b_coeffs[0].back().get());
     return hypre_solver;
 }
+
+bool
+MLEBABecLap::updateHypre (Hypre& hypre_solver) const
+{
+    auto* ijmatrix_solver = dynamic_cast<HypreABecLap3*>(&hypre_solver);
+    if (ijmatrix_solver == nullptr) { return false; }
+    ijmatrix_solver->setEBDirichlet(m_eb_b_coeffs[0].back().get());
+    return MLCellABecLap::updateHypre(hypre_solver);
+}
 #endif
 
 #ifdef AMREX_USE_PETSC
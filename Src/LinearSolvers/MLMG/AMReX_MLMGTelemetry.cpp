@@ -0,0 +1,191 @@
+#include <AMReX_MLMGTelemetry.H>
+#include <AMReX_FabArrayBase.H>
+#include <AMReX_GpuDevice.H>
+#include <AMReX_Print.H>
+#include <AMReX_Utility.H>
+
+#ifdef AMREX_TINY_PROFILING
+#include <AMReX_TinyProfiler.H>
+#endif
+
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+#include <string>
+
+namespace amrex {
+
+namespace {
+    // JSON has no representation of inf and nan (e.g., the residual of a
+    // diverged solve), so they are written as null.
+    struct JSONNumber
+    {
+        double v;
+    };
+
+    std::ostream& operator<< (std::ostream& os, JSONNumber x)
+    {
+        if (std::isfinite(x.v)) {
+            os << x.v;
+        } else {
+            os << "null";
+        }
+        return os;
+    }
+}
+
+const char*
+MLMGTelemetry::phaseName (int phase)
+{
+    switch (phase) {
+    case smooth:        return "smooth";
+    case restriction:   return "restriction";
+    case interpolation: return "interpolation";
+    case residual:      return "residual";
+    case bottom:        return "bottom";
+    case reduction:     return "reduction";
+    case communication: return "communication";
+    default:            return "unknown";
+    }
+}
+
+void
+MLMGTelemetry::reset (Vector<int> const& num_mg_levels)
+{
+    num_iters = 0;
+    rhs_norm = -1.0;
+    initial_residual = -1.0;
+    final_residual = -1.0;
+    solve_time = 0.0;
+    residual_history.clear();
+    bottom_iters.clear();
+    num_fill_boundary = 0;
+    num_reductions = 0;
+
+    Array<double,nphases> zero{};
+    level_time.resize(num_mg_levels.size());
+    for (int amrlev = 0; amrlev < int(num_mg_levels.size()); ++amrlev) {
+        level_time[amrlev].assign(num_mg_levels[amrlev], zero);
+    }
+}
+
+Array<double,MLMGTelemetry::nphases>
+MLMGTelemetry::totalTime () const
+{
+    Array<double,nphases> r{};
+    for (auto const& amrlev_time : level_time) {
+        for (auto const& t : amrlev_time) {
+            for (int p = 0; p < nphases; ++p) {
+                r[p] += t[p];
+            }
+        }
+    }
+    return r;
+}
+
+void
+MLMGTelemetry::writeJSON (std::ostream& os) const
+{
+    auto old_prec = os.precision(std::numeric_limits<double>::max_digits10);
+
+    os << "{\n"
+       << "  \"num_iters\": " << num_iters << ",\n"
+       << "  \"rhs_norm\": " << JSONNumber{rhs_norm} << ",\n"
+       << "  \"initial_residual\": " << JSONNumber{initial_residual} << ",\n"
+       << "  \"final_residual\": " << JSONNumber{final_residual} << ",\n"
+       << "  \"solve_time\": " << JSONNumber{solve_time} << ",\n"
+       << "  \"num_fill_boundary\": " << num_fill_boundary << ",\n"
+       << "  \"num_reductions\": " << num_reductions << ",\n";
+
+    os << "  \"residual_history\": [";
+    for (int i = 0; i < int(residual_history.size()); ++i) {
+        os << (i > 0 ? ", " : "") << JSONNumber{residual_history[i]};
+    }
+    os << "],\n";
+
+    os << "  \"bottom_iters\": [";
+    for (int i = 0; i < int(bottom_iters.size()); ++i) {
+        os << (i > 0 ? ", " : "") << bottom_iters[i];
+    }
+    os << "],\n";
+
+    os << "  \"level_time\": [";
+    bool first = true;
+    for (int amrlev = 0; amrlev < int(level_time.size()); ++amrlev) {
+        for (int mglev = 0; mglev < int(level_time[amrlev].size()); ++mglev) {
+            os << (first ? "\n" : ",\n")
+               << "    {\"amrlev\": " << amrlev << ", \"mglev\": " << mglev;
+            for (int p = 0; p < nphases; ++p) {
+                os << ", \"" << phaseName(p) << "\": " << JSONNumber{level_time[amrlev][mglev][p]};
+            }
+            os << "}";
+            first = false;
+        }
+    }
+    os << "\n  ]\n}\n";
+
+    os.precision(old_prec);
+}
+
+void
+MLMGTelemetry::print () const
+{
+    amrex::Print() << "MLMG telemetry: " << num_iters << " iterations, solve time = "
+                   << JSONNumber{solve_time} << ", # of FillBoundary = " << num_fill_boundary
+                   << ", # of reductions = " << num_reductions << "\n";
+    for (int amrlev = 0; amrlev < int(level_time.size()); ++amrlev) {
+        for (int mglev = 0; mglev < int(level_time[amrlev].size()); ++mglev) {
+            amrex::Print pout;
+            pout << "  AMR level " << amrlev << " MG level " << mglev << ":";
+            for (int p = 0; p < nphases; ++p) {
+                pout << " " << phaseName(p) << " = " << JSONNumber{level_time[amrlev][mglev][p]};
+            }
+            pout << "\n";
+        }
+    }
+}
+
+MLMGTelemetryScope::MLMGTelemetryScope (MLMGTelemetry* telemetry, int amrlev, int mglev,
+                                        MLMGTelemetry::Phase phase)
+{
+    if (telemetry == nullptr || telemetry->m_in_scope ||
+        amrlev >= int(telemetry->level_time.size()) ||
+        mglev >= int(telemetry->level_time[amrlev].size()))
+    {
+        return;
+    }
+
+    m_telemetry = telemetry;
+    m_telemetry->m_in_scope = true;
+    m_time = &(telemetry->level_time[amrlev][mglev][phase]);
+    m_comm_time = &(telemetry->level_time[amrlev][mglev][MLMGTelemetry::communication]);
+
+#ifdef AMREX_TINY_PROFILING
+    m_tprof = std::make_unique<TinyProfiler>(std::string("MLMG::")
+                                             + MLMGTelemetry::phaseName(phase) + "::"
+                                             + std::to_string(amrlev) + "_"
+                                             + std::to_string(mglev));
+#endif
+
+    Gpu::streamSynchronize();
+    m_start_time = amrex::second();
+    m_start_fb_time = FabArrayBase::m_FB_time;
+}
+
+MLMGTelemetryScope::~MLMGTelemetryScope ()
+{
+    if (m_telemetry == nullptr) { return; }
+
+    Gpu::streamSynchronize();
+    double fb_time = FabArrayBase::m_FB_time - m_start_fb_time;
+    *m_time += amrex::second() - m_start_time - fb_time;
+    *m_comm_time += fb_time;
+    m_telemetry->m_in_scope = false;
+
+#ifdef AMREX_TINY_PROFILING
+    m_tprof.reset();
+#endif
+}
+
+}
@@ -13,6 +13,118 @@
 
 namespace amrex {
 
+namespace {
+
+// The RAP stencil is stored in either Real or float.
+
+template <typename SMF>
+void restrictionRAP (MultiFab& crse, MultiFab const& fine, SMF const& sten,
+                     iMultiFab const& dmsk)
+{
+#ifdef AMREX_USE_GPU
+    if (Gpu::inLaunchRegion()) {
+        auto const& crse_ma = crse.arrays();
+        auto const& fine_ma = fine.const_arrays();
+        auto const& st_ma = sten.const_arrays();
+        auto const& msk_ma = dmsk.const_arrays();
+        ParallelFor(crse, [=] AMREX_GPU_DEVICE(int box_no, int i, int j, int k) noexcept
+        {
+            mlndlap_restriction_rap(i,j,k,crse_ma[box_no],fine_ma[box_no],st_ma[box_no],msk_ma[box_no]);
+        });
+        Gpu::streamSynchronize();
+    } else
+#endif
+    {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(crse, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            Array4<Real> cfab = crse.array(mfi);
+            Array4<Real const> const& ffab = fine.const_array(mfi);
+            auto const& stfab = sten.const_array(mfi);
+            Array4<int const> const& mfab = dmsk.const_array(mfi);
+            amrex::LoopConcurrentOnCpu(bx, [&] (int i, int j, int k) noexcept
+            {
+                mlndlap_restriction_rap(i,j,k,cfab,ffab,stfab,mfab);
+            });
+        }
+    }
+}
+
+template <typename SMF>
+void interpolationRAP (MultiFab& fine, MultiFab const& crse, SMF const& sten,
+                       iMultiFab const& dmsk)
+{
+#ifdef AMREX_USE_GPU
+    if (Gpu::inLaunchRegion()) {
+        auto const& fine_ma = fine.arrays();
+        auto const& crse_ma = crse.const_arrays();
+        auto const& sten_ma = sten.const_arrays();
+        auto const& msk_ma = dmsk.const_arrays();
+        ParallelFor(fine, [=] AMREX_GPU_DEVICE(int box_no, int i, int j, int k) noexcept
+        {
+            mlndlap_interpadd_rap(i, j, k, fine_ma[box_no], crse_ma[box_no], sten_ma[box_no], msk_ma[box_no]);
+        });
+        Gpu::streamSynchronize();
+    } else
+#endif
+    {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(fine, true); mfi.isValid(); ++mfi)
+        {
+            Box const& bx = mfi.tilebox();
+            Array4<Real> const& ffab = fine.array(mfi);
+            Array4<Real const> const& cfab = crse.const_array(mfi);
+            auto const& stfab = sten.const_array(mfi);
+            Array4<int const> const& mfab = dmsk.const_array(mfi);
+            amrex::LoopConcurrentOnCpu(bx, [&] (int i, int j, int k) noexcept
+            {
+                mlndlap_interpadd_rap(i,j,k,ffab,cfab,stfab,mfab);
+            });
+        }
+    }
+}
+
+template <typename SMF>
+void normalizeRAP (MultiFab& mf, SMF const& sten, iMultiFab const& dmsk, Real s0_norm0)
+{
+#ifdef AMREX_USE_GPU
+    if (Gpu::inLaunchRegion() && mf.isFusingCandidate()) {
+        const auto& ma = mf.arrays();
+        const auto& dmsk_ma = dmsk.const_arrays();
+        const auto& sten_ma = sten.const_arrays();
+        ParallelFor(mf,
+        [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k) noexcept
+        {
+            mlndlap_normalize_sten(i,j,k,ma[box_no],sten_ma[box_no],dmsk_ma[box_no],s0_norm0);
+        });
+        Gpu::streamSynchronize();
+    } else
+#endif
+    {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(mf,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            Array4<Real> const& arr = mf.array(mfi);
+            Array4<int const> const& dmskarr = dmsk.const_array(mfi);
+            auto const& stenarr = sten.const_array(mfi);
+            AMREX_HOST_DEVICE_PARALLEL_FOR_3D(bx, i, j, k,
+            {
+                mlndlap_normalize_sten(i,j,k,arr,stenarr,dmskarr,s0_norm0);
+            });
+        }
+    }
+}
+
+}
+
 MLNodeLaplacian::MLNodeLaplacian (const Vector<Geometry>& a_geom,
                                   const Vector<BoxArray>& a_grids,
                                   const Vector<DistributionMapping>& a_dmap,
@@ -132,6 +244,12 @@ MLNodeLaplacian::resizeMultiGrid (int new_size)
         }
     }
 
+    if (!   m_stencil_sp.empty()) {
+        if (m_stencil_sp[0].size() > new_size) {
+            m_stencil_sp[0].resize(new_size);
+        }
+    }
+
     if (!   m_s0_norm0.empty()) {
         if (m_s0_norm0[0].size() > new_size) {
             m_s0_norm0[0].resize(new_size);
@@ -483,7 +601,18 @@ MLNodeLaplacian::restriction (int amrlev, int cmglev, MultiFab& crse, MultiFab&
     MultiFab* pcrse = (need_parallel_copy) ? &cfine : &crse;
     const iMultiFab& dmsk = *m_dirichlet_mask[amrlev][cmglev-1];
 
-    const auto& stencil = m_stencil[amrlev][cmglev-1];
+    if (m_coarsening_strategy == CoarseningStrategy::RAP)
+    {
+        if (m_stencil_sp[amrlev][cmglev-1]) {
+            restrictionRAP(*pcrse, fine, *m_stencil_sp[amrlev][cmglev-1], dmsk);
+        } else {
+            restrictionRAP(*pcrse, fine, *m_stencil[amrlev][cmglev-1], dmsk);
+        }
+        if (need_parallel_copy) {
+            crse.ParallelCopy(cfine);
+        }
+        return;
+    }
 
     bool regular_coarsening = true;
 #if (AMREX_SPACEDIM == 1)
@@ -524,14 +653,6 @@ MLNodeLaplacian::restriction (int amrlev, int cmglev, MultiFab& crse, MultiFab&
                 });
             }
         }
-        else
-        {
-            auto st_ma = stencil->const_arrays();
-            ParallelFor(*pcrse, [=] AMREX_GPU_DEVICE(int box_no, int i, int j, int k) noexcept
-            {
-                mlndlap_restriction_rap(i,j,k,pcrse_ma[box_no],fine_ma[box_no],st_ma[box_no],msk_ma[box_no]);
-            });
-        }
         Gpu::streamSynchronize();
     } else
 #endif
@@ -562,14 +683,6 @@ MLNodeLaplacian::restriction (int amrlev, int cmglev, MultiFab& crse, MultiFab&
                     });
                 }
             }
-            else
-            {
-                Array4<Real const> const& stfab = stencil->const_array(mfi);
-                amrex::LoopConcurrentOnCpu(bx, [&] (int i, int j, int k) noexcept
-                {
-                    mlndlap_restriction_rap(i,j,k,cfab,ffab,stfab,mfab);
-                });
-            }
         }
     }
 
@@ -584,7 +697,6 @@ MLNodeLaplacian::interpolation (int amrlev, int fmglev, MultiFab& fine, const Mu
     BL_PROFILE("MLNodeLaplacian::interpolation()");
 
     const auto& sigma = m_sigma[amrlev][fmglev];
-    const auto& stencil = m_stencil[amrlev][fmglev];
 
     bool need_parallel_copy = !amrex::isMFIterSafe(crse, fine);
     MultiFab cfine;
@@ -598,6 +710,16 @@ MLNodeLaplacian::interpolation (int amrlev, int fmglev, MultiFab& fine, const Mu
 
     const iMultiFab& dmsk = *m_dirichlet_mask[amrlev][fmglev];
 
+    if (m_coarsening_strategy == CoarseningStrategy::RAP)
+    {
+        if (m_stencil_sp[amrlev][fmglev]) {
+            interpolationRAP(fine, *cmf, *m_stencil_sp[amrlev][fmglev], dmsk);
+        } else {
+            interpolationRAP(fine, *cmf, *m_stencil[amrlev][fmglev], dmsk);
+        }
+        return;
+    }
+
     bool regular_coarsening = true;
 #if (AMREX_SPACEDIM == 1)
     int idir = 0;
@@ -623,15 +745,7 @@ MLNodeLaplacian::interpolation (int amrlev, int fmglev, MultiFab& fine, const Mu
     auto msk_ma = dmsk.const_arrays();
 
     if (Gpu::inLaunchRegion()) {
-        if (m_coarsening_strategy == CoarseningStrategy::RAP)
-        {
-            auto sten_ma = stencil->const_arrays();
-            ParallelFor(fine, [=] AMREX_GPU_DEVICE(int box_no, int i, int j, int k) noexcept
-            {
-                mlndlap_interpadd_rap(i, j, k, fine_ma[box_no], crse_ma[box_no], sten_ma[box_no], msk_ma[box_no]);
-            });
-        }
-        else if (sigma[0] == nullptr)
+        if (sigma[0] == nullptr)
         {
             ParallelFor(fine, [=] AMREX_GPU_DEVICE(int box_no, int i, int j, int k) noexcept
             {
@@ -678,15 +792,7 @@ MLNodeLaplacian::interpolation (int amrlev, int fmglev, MultiFab& fine, const Mu
             Array4<Real> const& ffab = fine.array(mfi);
             Array4<Real const> const& cfab = cmf->const_array(mfi);
             Array4<int const> const& mfab = dmsk.const_array(mfi);
-            if (m_coarsening_strategy == CoarseningStrategy::RAP)
-            {
-                Array4<Real const> const& stfab = stencil->const_array(mfi);
-                amrex::LoopConcurrentOnCpu(bx, [&] (int i, int j, int k) noexcept
-                {
-                    mlndlap_interpadd_rap(i,j,k,ffab,cfab,stfab,mfab);
-                });
-            }
-            else if (sigma[0] == nullptr)
+            if (sigma[0] == nullptr)
             {
                 amrex::LoopConcurrentOnCpu(bx, [&] (int i, int j, int k) noexcept
                 {
@@ -843,26 +949,26 @@ MLNodeLaplacian::normalize (int amrlev, int mglev, MultiFab& mf) const
     if (m_sigma[0][0][0] == nullptr) { return; }
 
     const auto& sigma = m_sigma[amrlev][mglev];
-    const auto& stencil = m_stencil[amrlev][mglev];
     const auto dxinv = m_geom[amrlev][mglev].InvCellSizeArray();
     const iMultiFab& dmsk = *m_dirichlet_mask[amrlev][mglev];
-    const Real s0_norm0 = m_s0_norm0[amrlev][mglev];
+
+    if (m_coarsening_strategy == CoarseningStrategy::RAP)
+    {
+        const Real s0_norm0 = m_s0_norm0[amrlev][mglev];
+        if (m_stencil_sp[amrlev][mglev]) {
+            normalizeRAP(mf, *m_stencil_sp[amrlev][mglev], dmsk, s0_norm0);
+        } else {
+            normalizeRAP(mf, *m_stencil[amrlev][mglev], dmsk, s0_norm0);
+        }
+        return;
+    }
 
 #ifdef AMREX_USE_GPU
     if (Gpu::inLaunchRegion() && mf.isFusingCandidate()) {
         const auto& ma = mf.arrays();
         const auto& dmsk_ma = dmsk.const_arrays();
 
-        if (m_coarsening_strategy == CoarseningStrategy::RAP)
-        {
-            const auto& sten_ma = stencil->const_arrays();
-            ParallelFor(mf,
-            [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k) noexcept
-            {
-                mlndlap_normalize_sten(i,j,k,ma[box_no],sten_ma[box_no],dmsk_ma[box_no],s0_norm0);
-            });
-        }
-        else if ( (m_use_harmonic_average && mglev > 0) ||
+        if ( (m_use_harmonic_average && mglev > 0) ||
                    m_use_mapped )
         {
             AMREX_D_TERM(const auto& sx_ma = sigma[0]->const_arrays();,
@@ -895,16 +1001,7 @@ MLNodeLaplacian::normalize (int amrlev, int mglev, MultiFab& mf) const
             const Box& bx = mfi.tilebox();
             Array4<Real> const& arr = mf.array(mfi);
             Array4<int const> const& dmskarr = dmsk.const_array(mfi);
-            if (m_coarsening_strategy == CoarseningStrategy::RAP)
-            {
-                Array4<Real const> const& stenarr = stencil->const_array(mfi);
-
-                AMREX_HOST_DEVICE_PARALLEL_FOR_3D(bx, i, j, k,
-                {
-                    mlndlap_normalize_sten(i,j,k,arr,stenarr,dmskarr,s0_norm0);
-                });
-            }
-            else if ( (m_use_harmonic_average && mglev > 0) ||
+            if ( (m_use_harmonic_average && mglev > 0) ||
                        m_use_mapped )
             {
                 AMREX_D_TERM(Array4<Real const> const& sxarr = sigma[0]->const_array(mfi);,
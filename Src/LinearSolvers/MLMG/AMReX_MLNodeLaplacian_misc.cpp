@@ -13,6 +13,125 @@
 
 namespace amrex {
 
+namespace {
+
+// The RAP stencil is stored in either Real or float.
+
+template <typename SMF>
+void applyRAP (MultiFab& out, MultiFab const& in, SMF const& sten, iMultiFab const& dmsk)
+{
+#ifdef AMREX_USE_GPU
+    if (Gpu::inLaunchRegion()) {
+        auto xarr_ma = in.const_arrays();
+        auto yarr_ma = out.arrays();
+        auto dmskarr_ma = dmsk.const_arrays();
+        auto stenarr_ma = sten.const_arrays();
+        ParallelFor(out, [=] AMREX_GPU_DEVICE(int box_no, int i, int j, int k) noexcept
+        {
+            yarr_ma[box_no](i,j,k) = mlndlap_adotx_sten(i,j,k,xarr_ma[box_no],stenarr_ma[box_no],dmskarr_ma[box_no]);
+        });
+        Gpu::streamSynchronize();
+    } else
+#endif
+    {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(out,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            Array4<Real const> const& xarr = in.const_array(mfi);
+            Array4<Real> const& yarr = out.array(mfi);
+            Array4<int const> const& dmskarr = dmsk.const_array(mfi);
+            auto const& stenarr = sten.const_array(mfi);
+            amrex::LoopConcurrentOnCpu(bx, [&] (int i, int j, int k) noexcept
+            {
+                yarr(i,j,k) = mlndlap_adotx_sten(i,j,k,xarr,stenarr,dmskarr);
+            });
+        }
+    }
+}
+
+template <typename SMF>
+void gaussSeidelRAP (MultiFab& sol, MultiFab const& rhs, SMF const& sten,
+                     iMultiFab const& dmsk, int nsweeps)
+{
+#ifdef AMREX_USE_GPU
+    if (Gpu::inLaunchRegion())
+    {
+        auto const& solarr_ma = sol.arrays();
+        auto const& rhsarr_ma = rhs.const_arrays();
+        auto const& dmskarr_ma = dmsk.const_arrays();
+        auto const& starr_ma = sten.const_arrays();
+        for (int color = 0; color < AMREX_D_TERM(2,*2,*2); ++color)
+        {
+            ParallelFor(sol, [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k) noexcept
+            {
+                mlndlap_gscolor_sten(i,j,k,solarr_ma[box_no],rhsarr_ma[box_no],
+                                     starr_ma[box_no],dmskarr_ma[box_no],color);
+            });
+        }
+    } else
+#endif
+    {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(sol); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.validbox();
+            Array4<Real> const& solarr = sol.array(mfi);
+            Array4<Real const> const& rhsarr = rhs.const_array(mfi);
+            auto const& starr = sten.const_array(mfi);
+            Array4<int const> const& dmskarr = dmsk.const_array(mfi);
+
+            for (int ns = 0; ns < nsweeps; ++ns) {
+                mlndlap_gauss_seidel_sten(bx,solarr,rhsarr,starr,dmskarr);
+            }
+        }
+    }
+}
+
+template <typename SMF>
+void jacobiRAP (MultiFab& sol, MultiFab const& Ax, MultiFab const& rhs, SMF const& sten,
+                iMultiFab const& dmsk)
+{
+#ifdef AMREX_USE_GPU
+    if (Gpu::inLaunchRegion())
+    {
+        auto const& solarr_ma = sol.arrays();
+        auto const& Axarr_ma = Ax.const_arrays();
+        auto const& rhsarr_ma = rhs.const_arrays();
+        auto const& dmskarr_ma = dmsk.const_arrays();
+        auto const& starr_ma = sten.const_arrays();
+        ParallelFor(sol, [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k) noexcept
+        {
+            mlndlap_jacobi_sten(i,j,k,solarr_ma[box_no],Axarr_ma[box_no](i,j,k),
+                                rhsarr_ma[box_no],starr_ma[box_no],
+                                dmskarr_ma[box_no]);
+        });
+    } else
+#endif
+    {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(sol,true); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            Array4<Real> const& solarr = sol.array(mfi);
+            Array4<Real const> const& Axarr = Ax.const_array(mfi);
+            Array4<Real const> const& rhsarr = rhs.const_array(mfi);
+            auto const& stenarr = sten.const_array(mfi);
+            Array4<int const> const& dmskarr = dmsk.const_array(mfi);
+
+            mlndlap_jacobi_sten(bx,solarr,Axarr,rhsarr,stenarr,dmskarr);
+        }
+    }
+}
+
+}
+
 void
 MLNodeLaplacian::averageDownCoeffs ()
 {
@@ -201,7 +320,6 @@ MLNodeLaplacian::Fapply (int amrlev, int mglev, MultiFab& out, const MultiFab& i
     BL_PROFILE("MLNodeLaplacian::Fapply()");
 
     const auto& sigma = m_sigma[amrlev][mglev];
-    const auto& stencil = m_stencil[amrlev][mglev];
     const auto dxinvarr = m_geom[amrlev][mglev].InvCellSizeArray();
 #if (AMREX_SPACEDIM == 2)
     bool is_rz = m_is_rz;
@@ -209,6 +327,15 @@ MLNodeLaplacian::Fapply (int amrlev, int mglev, MultiFab& out, const MultiFab& i
 
     const iMultiFab& dmsk = *m_dirichlet_mask[amrlev][mglev];
 
+    if (m_coarsening_strategy == CoarseningStrategy::RAP)
+    {
+        if (m_stencil_sp[amrlev][mglev]) {
+            applyRAP(out, in, *m_stencil_sp[amrlev][mglev], dmsk);
+        } else {
+            applyRAP(out, in, *m_stencil[amrlev][mglev], dmsk);
+        }
+        return;
+    }
 
 #ifdef AMREX_USE_GPU
     if (Gpu::inLaunchRegion()) {
@@ -216,15 +343,7 @@ MLNodeLaplacian::Fapply (int amrlev, int mglev, MultiFab& out, const MultiFab& i
         auto yarr_ma = out.arrays();
         auto dmskarr_ma = dmsk.const_arrays();
 
-        if (m_coarsening_strategy == CoarseningStrategy::RAP)
-        {
-            auto stenarr_ma = stencil->const_arrays();
-            ParallelFor(out, [=] AMREX_GPU_DEVICE(int box_no, int i, int j, int k) noexcept
-            {
-                yarr_ma[box_no](i,j,k) = mlndlap_adotx_sten(i,j,k,xarr_ma[box_no],stenarr_ma[box_no],dmskarr_ma[box_no]);
-            });
-        }
-        else if (sigma[0] == nullptr)
+        if (sigma[0] == nullptr)
         {
             Real const_sigma = m_const_sigma;
             ParallelFor(out, [=] AMREX_GPU_DEVICE(int box_no, int i, int j, int k) noexcept
@@ -279,15 +398,7 @@ MLNodeLaplacian::Fapply (int amrlev, int mglev, MultiFab& out, const MultiFab& i
             Array4<Real> const& yarr = out.array(mfi);
             Array4<int const> const& dmskarr = dmsk.const_array(mfi);
 
-            if (m_coarsening_strategy == CoarseningStrategy::RAP)
-            {
-                Array4<Real const> const& stenarr = stencil->const_array(mfi);
-                amrex::LoopConcurrentOnCpu(bx, [&] (int i, int j, int k) noexcept
-                {
-                    yarr(i,j,k) = mlndlap_adotx_sten(i,j,k,xarr,stenarr,dmskarr);
-                });
-            }
-            else if (sigma[0] == nullptr)
+            if (sigma[0] == nullptr)
             {
                 Real const_sigma = m_const_sigma;
 #if (AMREX_SPACEDIM == 2)
@@ -348,6 +459,7 @@ MLNodeLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab&
 
     const auto& sigma = m_sigma[amrlev][mglev];
     const auto& stencil = m_stencil[amrlev][mglev];
+    const auto& stencil_sp = m_stencil_sp[amrlev][mglev];
     const auto dxinvarr = m_geom[amrlev][mglev].InvCellSizeArray();
 #if (AMREX_SPACEDIM == 2)
     bool is_rz = m_is_rz;
@@ -374,36 +486,10 @@ MLNodeLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab&
     {
         if (m_coarsening_strategy == CoarseningStrategy::RAP)
         {
-#ifdef AMREX_USE_GPU
-            if (Gpu::inLaunchRegion())
-            {
-                auto const& starr_ma = stencil->const_arrays();
-                for (int color = 0; color < AMREX_D_TERM(2,*2,*2); ++color)
-                {
-                    ParallelFor(sol, [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k) noexcept
-                    {
-                        mlndlap_gscolor_sten(i,j,k,solarr_ma[box_no],rhsarr_ma[box_no],
-                                             starr_ma[box_no],dmskarr_ma[box_no],color);
-                    });
-                }
-            } else
-#endif
-            {
-#ifdef AMREX_USE_OMP
-#pragma omp parallel
-#endif
-                for (MFIter mfi(sol); mfi.isValid(); ++mfi)
-                {
-                    const Box& bx = mfi.validbox();
-                    Array4<Real> const& solarr = sol.array(mfi);
-                    Array4<Real const> const& rhsarr = rhs.const_array(mfi);
-                    Array4<Real const> const& starr = stencil->const_array(mfi);
-                    Array4<int const> const& dmskarr = dmsk.const_array(mfi);
-
-                    for (int ns = 0; ns < m_smooth_num_sweeps; ++ns) {
-                        mlndlap_gauss_seidel_sten(bx,solarr,rhsarr,starr,dmskarr);
-                    }
-                }
+            if (stencil_sp) {
+                gaussSeidelRAP(sol, rhs, *stencil_sp, dmsk, m_smooth_num_sweeps);
+            } else {
+                gaussSeidelRAP(sol, rhs, *stencil, dmsk, m_smooth_num_sweeps);
             }
         }
         else if (sigma[0] == nullptr)
@@ -572,33 +658,10 @@ MLNodeLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab&
 
         if (m_coarsening_strategy == CoarseningStrategy::RAP)
         {
-#ifdef AMREX_USE_GPU
-            if (Gpu::inLaunchRegion())
-            {
-                auto const& starr_ma = stencil->const_arrays();
-                ParallelFor(sol, [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k) noexcept
-                {
-                    mlndlap_jacobi_sten(i,j,k,solarr_ma[box_no],Axarr_ma[box_no](i,j,k),
-                                        rhsarr_ma[box_no],starr_ma[box_no],
-                                        dmskarr_ma[box_no]);
-                });
-            } else
-#endif
-            {
-#ifdef AMREX_USE_OMP
-#pragma omp parallel
-#endif
-                for (MFIter mfi(sol,true); mfi.isValid(); ++mfi)
-                {
-                    const Box& bx = mfi.tilebox();
-                    Array4<Real> const& solarr = sol.array(mfi);
-                    Array4<Real const> const& Axarr = Ax.const_array(mfi);
-                    Array4<Real const> const& rhsarr = rhs.const_array(mfi);
-                    Array4<Real const> const& stenarr = stencil->const_array(mfi);
-                    Array4<int const> const& dmskarr = dmsk.const_array(mfi);
-
-                    mlndlap_jacobi_sten(bx,solarr,Axarr,rhsarr,stenarr,dmskarr);
-                }
+            if (stencil_sp) {
+                jacobiRAP(sol, Ax, rhs, *stencil_sp, dmsk);
+            } else {
+                jacobiRAP(sol, Ax, rhs, *stencil, dmsk);
             }
         }
         else if (sigma[0] == nullptr)
@@ -17,11 +17,14 @@ void
 MLNodeLaplacian::buildStencil ()
 {
     m_stencil.resize(m_num_amr_levels);
+    m_stencil_sp.clear();
+    m_stencil_sp.resize(m_num_amr_levels);
     m_nosigma_stencil.resize(m_num_amr_levels);
     m_s0_norm0.resize(m_num_amr_levels);
     for (int amrlev = 0; amrlev < m_num_amr_levels; ++amrlev)
     {
         m_stencil[amrlev].resize(m_num_mg_levels[amrlev]);
+        m_stencil_sp[amrlev].resize(m_num_mg_levels[amrlev]);
         m_s0_norm0[amrlev].resize(m_num_mg_levels[amrlev],0.0);
     }
 
@@ -363,6 +366,34 @@ MLNodeLaplacian::buildStencil ()
 
     // This is only needed at the bottom.
     m_s0_norm0[0].back() = m_stencil[0].back()->norm0(0,0) * m_normalization_threshold;
+
+    if (m_single_precision_stencil)
+    {
+        // The finest level is used for the residual, and the bottom level
+        // may be needed by the bottom solver (e.g., hypre) in Real.
+        auto use_sp = [&] (int amrlev, int mglev) {
+            return mglev > 0 && (amrlev > 0 || mglev+1 < m_num_mg_levels[amrlev]);
+        };
+        for (int amrlev = 0; amrlev < m_num_amr_levels; ++amrlev) {
+            for (int mglev = 0; mglev < m_num_mg_levels[amrlev]; ++mglev) {
+                if (use_sp(amrlev, mglev)) {
+                    auto const& sten = *m_stencil[amrlev][mglev];
+                    m_stencil_sp[amrlev][mglev] = std::make_unique<fMultiFab>
+                        (sten.boxArray(), sten.DistributionMap(), sten.nComp(), sten.nGrowVect());
+                    m_stencil_sp[amrlev][mglev]->LocalCopy(sten, 0, 0, sten.nComp(),
+                                                           sten.nGrowVect());
+                }
+            }
+        }
+        Gpu::streamSynchronize();
+        for (int amrlev = 0; amrlev < m_num_amr_levels; ++amrlev) {
+            for (int mglev = 0; mglev < m_num_mg_levels[amrlev]; ++mglev) {
+                if (use_sp(amrlev, mglev)) {
+                    m_stencil[amrlev][mglev].reset();
+                }
+            }
+        }
+    }
 }
 
 }
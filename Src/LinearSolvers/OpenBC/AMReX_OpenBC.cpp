@@ -202,10 +202,54 @@ void OpenBCSolver::useHypre (bool use_hypre) noexcept
     }
 }
 
+void OpenBCSolver::useFFT (bool use_fft)
+{
+    m_use_fft = use_fft;
+#ifndef AMREX_USE_FFT
+    if (use_fft) {
+        amrex::Abort("OpenBCSolver: Must enable FFT support to use it.");
+    }
+#endif
+}
+
+void OpenBCSolver::setup_mlmg_1 ()
+{
+    int nlevels = static_cast<int>(m_geom.size());
+
+    m_poisson_1 = std::make_unique<MLPoisson>(m_geom, m_grids, m_dmap, m_info);
+    m_poisson_1->setVerbose(m_verbose);
+    m_poisson_1->setMaxOrder(4);
+    m_poisson_1->setDomainBC({AMREX_D_DECL(LinOpBCType::Dirichlet,
+                                           LinOpBCType::Dirichlet,
+                                           LinOpBCType::Dirichlet)},
+                             {AMREX_D_DECL(LinOpBCType::Dirichlet,
+                                           LinOpBCType::Dirichlet,
+                                           LinOpBCType::Dirichlet)});
+    for (int ilev = 0; ilev < nlevels; ++ilev) {
+        m_poisson_1->setLevelBC(ilev, nullptr);
+    }
+
+    m_mlmg_1 = std::make_unique<MLMG>(*m_poisson_1);
+    m_mlmg_1->setVerbose(m_verbose);
+    m_mlmg_1->setBottomVerbose(m_bottom_verbose);
+    m_mlmg_1->setBottomSolver(m_bottom_solver_type);
+#ifdef AMREX_USE_HYPRE
+    if (m_bottom_solver_type == BottomSolver::hypre) {
+        m_mlmg_1->setHypreInterface(Hypre::Interface::structed);
+    }
+#endif
+}
+
 Real OpenBCSolver::solve (const Vector<MultiFab*>& a_sol,
                           const Vector<MultiFab const*>& a_rhs,
                           Real a_tol_rel, Real a_tol_abs)
 {
+#ifdef AMREX_USE_FFT
+    if (m_use_fft) {
+        return solve_fft(a_sol, a_rhs, a_tol_rel, a_tol_abs);
+    }
+#endif
+
     BL_PROFILE("OpenBCSolver::solve()");
 
     auto solve_start_time = amrex::second();
@@ -215,28 +259,7 @@ Real OpenBCSolver::solve (const Vector<MultiFab*>& a_sol,
     BL_PROFILE_VAR("OpenBCSolver::MG1", blp_mg1);
 
     if (m_poisson_1 == nullptr) {
-        m_poisson_1 = std::make_unique<MLPoisson>(m_geom, m_grids, m_dmap, m_info);
-        m_poisson_1->setVerbose(m_verbose);
-        m_poisson_1->setMaxOrder(4);
-        m_poisson_1->setDomainBC({AMREX_D_DECL(LinOpBCType::Dirichlet,
-                                               LinOpBCType::Dirichlet,
-                                               LinOpBCType::Dirichlet)},
-                                 {AMREX_D_DECL(LinOpBCType::Dirichlet,
-                                               LinOpBCType::Dirichlet,
-                                               LinOpBCType::Dirichlet)});
-        for (int ilev = 0; ilev < nlevels; ++ilev) {
-            m_poisson_1->setLevelBC(ilev, nullptr);
-        }
-
-        m_mlmg_1 = std::make_unique<MLMG>(*m_poisson_1);
-        m_mlmg_1->setVerbose(m_verbose);
-        m_mlmg_1->setBottomVerbose(m_bottom_verbose);
-        m_mlmg_1->setBottomSolver(m_bottom_solver_type);
-#ifdef AMREX_USE_HYPRE
-        if (m_bottom_solver_type == BottomSolver::hypre) {
-            m_mlmg_1->setHypreInterface(Hypre::Interface::structed);
-        }
-#endif
+        setup_mlmg_1();
     }
     m_mlmg_1->solve(a_sol, a_rhs, a_tol_rel, a_tol_abs);
 
@@ -380,6 +403,86 @@ Real OpenBCSolver::solve (const Vector<MultiFab*>& a_sol,
     return err;
 }
 
+#ifdef AMREX_USE_FFT
+Real OpenBCSolver::solve_fft (const Vector<MultiFab*>& a_sol,
+                              const Vector<MultiFab const*>& a_rhs,
+                              Real a_tol_rel, Real a_tol_abs)
+{
+    BL_PROFILE("OpenBCSolver::solve_fft()");
+
+    auto solve_start_time = amrex::second();
+
+    Box const domain0 = m_geom[0].Domain();
+    // The potential is needed in the cells just outside the domain.
+    Box const domain1 = amrex::grow(domain0, 1);
+
+    if (m_fft_solver == nullptr) {
+        m_fft_solver = std::make_unique<FFT::OpenBCSolver<Real>>(domain1);
+        auto const dx = m_geom[0].CellSizeArray();
+        m_fft_solver->setGreensFunction([=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            return openbc::integrated_greens_function(i,j,k,dx);
+        });
+
+        BoxArray ba(domain1);
+        ba.maxSize(64);
+        m_fft_phi.define(ba, DistributionMapping{ba}, 1, 0);
+
+        setup_mlmg_1();
+    }
+
+    BL_PROFILE_VAR("OpenBCSolver::FFT", blp_fft);
+
+    m_fft_solver->solve(m_fft_phi, *a_rhs[0]);
+
+    MultiFab bcdata(m_grids[0], m_dmap[0], 1, 1);
+    bcdata.setVal(0._rt);
+    bcdata.ParallelCopy(m_fft_phi, 0, 0, 1, IntVect(0), IntVect(1));
+
+    // Dirichlet boundary values are on the domain faces, and they are
+    // interpolated from the cell centered potential.
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(bcdata); mfi.isValid(); ++mfi)
+    {
+        Box const& gbx = mfi.fabbox();
+        Array4<Real> const& bc = bcdata.array(mfi);
+        for (OrientationIter oit; oit.isValid(); ++oit) {
+            Orientation face = oit();
+            int idim = face.coordDir();
+            Box const b = gbx & amrex::adjCell(domain0, face);
+            if (b.ok()) {
+                IntVect const shift = face.isLow() ? IntVect::TheDimensionVector(idim)
+                    : -IntVect::TheDimensionVector(idim);
+                amrex::ParallelFor(b, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+                {
+                    IntVect const iv(i,j,k);
+                    bc(iv) = Real(0.5)*(bc(iv) + bc(iv+shift));
+                });
+            }
+        }
+    }
+
+    BL_PROFILE_VAR_STOP(blp_fft);
+
+    BL_PROFILE_VAR("OpenBCSolver::MG1", blp_mg1);
+
+    m_poisson_1->setLevelBC(0, &bcdata);
+    Real err = m_mlmg_1->solve(a_sol, a_rhs, a_tol_rel, a_tol_abs);
+
+    BL_PROFILE_VAR_STOP(blp_mg1);
+
+    auto solve_stop_time = amrex::second();
+    if (m_verbose >= 1) {
+        amrex::Print() << "OpenBCSolver time = "
+                       << solve_stop_time - solve_start_time << "\n";
+    }
+
+    return err;
+}
+#endif
+
 void OpenBCSolver::compute_moments (Gpu::DeviceVector<openbc::Moments>& moments)
 {
     BL_PROFILE("OpenBCSolver::comp_mom()");
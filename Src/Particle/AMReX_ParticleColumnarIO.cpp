@@ -0,0 +1,269 @@
+#include <AMReX_ParticleColumnarIO.H>
+#include <AMReX_ParticleContainerBase.H>
+#include <AMReX_Particle.H>
+#include <AMReX_NFiles.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_iMultiFab.H>
+#include <AMReX_Utility.H>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace amrex {
+
+namespace {
+
+Vector<int> selectComps (const Vector<std::string>& requested,
+                         const Vector<std::string>& names)
+{
+    Vector<int> selected(names.size(), requested.empty() ? 1 : 0);
+    for (const auto& r : requested) {
+        auto it = std::find(names.begin(), names.end(), r);
+        if (it == names.end()) {
+            amrex::Abort("ParticleReadSubset: no particle component named " + r);
+        }
+        selected[std::distance(names.begin(), it)] = 1;
+    }
+    return selected;
+}
+
+template <typename T>
+void readColumn (std::ifstream& ifs, Long offset, Long count, Vector<T>& column)
+{
+    column.resize(count);
+    ifs.seekg(offset, std::ios::beg);
+    ifs.read(reinterpret_cast<char*>(column.data()), std::streamsize(count*sizeof(T)));
+    if (!ifs.good()) {
+        amrex::Abort("ColumnarParticleReader: problem reading particle data");
+    }
+}
+
+void readRealColumn (std::ifstream& ifs, Long offset, Long count, int real_size,
+                     Vector<ParticleReal>& column)
+{
+    if (real_size == int(sizeof(ParticleReal))) {
+        readColumn(ifs, offset, count, column);
+    } else if (real_size == int(sizeof(float))) {
+        Vector<float> tmp;
+        readColumn(ifs, offset, count, tmp);
+        column.assign(tmp.begin(), tmp.end());
+    } else {
+        Vector<double> tmp;
+        readColumn(ifs, offset, count, tmp);
+        column.assign(tmp.begin(), tmp.end());
+    }
+}
+
+}
+
+Vector<int> ParticleReadSubset::selectReal (const Vector<std::string>& names) const
+{
+    return selectComps(real_comps, names);
+}
+
+Vector<int> ParticleReadSubset::selectInt (const Vector<std::string>& names) const
+{
+    return selectComps(int_comps, names);
+}
+
+namespace particle_detail {
+
+bool useColumnarIO ()
+{
+    bool columnar = false;
+    ParmParse pp("particles");
+    pp.query("columnar_io", columnar);
+    return columnar;
+}
+
+void writeColumnarPadding (std::ostream& os)
+{
+    static const char zeros[ColumnarAlignment] = {};
+    auto pos = static_cast<Long>(os.tellp());
+    auto npad = columnarPaddedBytes(pos) - pos;
+    if (npad > 0) { os.write(zeros, std::streamsize(npad)); }
+}
+
+}
+
+ColumnarParticleReader::ColumnarParticleReader (const std::string& dir, const std::string& name)
+{
+    m_dir = dir;
+    if (!m_dir.empty() && m_dir.back() != '/') { m_dir += '/'; }
+    m_dir += name;
+
+    std::string hdr_name = m_dir + "/Header";
+    std::ifstream hdr(hdr_name);
+    if (!hdr.good()) { amrex::FileOpenFailed(hdr_name); }
+
+    std::string version;
+    hdr >> version;
+    if (version.find(ParticleContainerBase::ColumnarVersion()) == std::string::npos) {
+        amrex::Abort("ColumnarParticleReader: " + hdr_name + " is not in the columnar format; "
+                     "write it with particles.columnar_io = 1");
+    }
+    m_real_size = (version.find("_single") != std::string::npos) ? 4 : 8;
+
+    int dm = 0;
+    hdr >> dm;
+    if (dm != AMREX_SPACEDIM) {
+        amrex::Abort("ColumnarParticleReader: dm != AMREX_SPACEDIM");
+    }
+
+    int nr = 0;
+    hdr >> nr;
+    m_real_names.resize(nr);
+    for (auto& n : m_real_names) { hdr >> n; }
+
+    int ni = 0;
+    hdr >> ni;
+    m_int_names.resize(ni);
+    for (auto& n : m_int_names) { hdr >> n; }
+
+    Long maxnextid = 0;
+    hdr >> m_is_checkpoint >> m_nparticles >> maxnextid >> m_finest_level;
+
+    m_grids.resize(m_finest_level+1);
+    for (auto& grids : m_grids) {
+        int ngrids = 0;
+        hdr >> ngrids;
+        grids.resize(ngrids);
+    }
+
+    for (auto& grids : m_grids) {
+        for (auto& g : grids) {
+            hdr >> g.which >> g.count >> g.where;
+            for (auto& x : g.bbox) { hdr >> x; }
+        }
+    }
+
+    if (!hdr.good()) {
+        amrex::Abort("ColumnarParticleReader: problem reading " + hdr_name);
+    }
+}
+
+RealBox ColumnarParticleReader::boundingBox (int lev, int grid) const noexcept
+{
+    const auto& g = m_grids[lev][grid];
+    if (g.count == 0) { return RealBox{}; }
+    Real lo[AMREX_SPACEDIM];
+    Real hi[AMREX_SPACEDIM];
+    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+        lo[d] = Real(g.bbox[d]);
+        hi[d] = Real(g.bbox[AMREX_SPACEDIM+d]);
+    }
+    return RealBox(lo, hi);
+}
+
+ParticleColumnData ColumnarParticleReader::read (const ParticleReadSubset& subset) const
+{
+    ParticleColumnData data;
+    for (int lev = 0; lev <= m_finest_level; ++lev) {
+        auto level_data = read(lev, subset);
+        if (lev == 0) {
+            data = std::move(level_data);
+            continue;
+        }
+        auto append = [] (auto& dst, const auto& src) { dst.insert(dst.end(), src.begin(), src.end()); };
+        append(data.id, level_data.id);
+        append(data.cpu, level_data.cpu);
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) { append(data.pos[d], level_data.pos[d]); }
+        for (int i = 0; i < data.real_data.size(); ++i) { append(data.real_data[i], level_data.real_data[i]); }
+        for (int i = 0; i < data.int_data.size(); ++i) { append(data.int_data[i], level_data.int_data[i]); }
+    }
+    return data;
+}
+
+ParticleColumnData ColumnarParticleReader::read (int lev, const ParticleReadSubset& subset) const
+{
+    BL_PROFILE("ColumnarParticleReader::read()");
+    AMREX_ALWAYS_ASSERT(lev >= 0 && lev <= m_finest_level);
+
+    Vector<int> real_comps;
+    Vector<int> int_comps;
+    {
+        auto sel_real = subset.selectReal(m_real_names);
+        auto sel_int = subset.selectInt(m_int_names);
+        for (int i = 0; i < sel_real.size(); ++i) { if (sel_real[i]) { real_comps.push_back(i); } }
+        for (int i = 0; i < sel_int.size(); ++i) { if (sel_int[i]) { int_comps.push_back(i); } }
+    }
+
+    ParticleColumnData data;
+    data.real_data.resize(real_comps.size());
+    data.int_data.resize(int_comps.size());
+
+    for (int grid = 0; grid < numGrids(lev); ++grid) {
+        const auto& g = m_grids[lev][grid];
+        if (g.count == 0 ||
+            !subset.intersects(g.bbox.data(), g.bbox.data()+AMREX_SPACEDIM)) { continue; }
+        readGrid(lev, grid, subset, real_comps, int_comps, data);
+    }
+    return data;
+}
+
+void ColumnarParticleReader::readGrid (int lev, int grid, const ParticleReadSubset& subset,
+                                       const Vector<int>& real_comps, const Vector<int>& int_comps,
+                                       ParticleColumnData& data) const
+{
+    const auto& g = m_grids[lev][grid];
+    const Long n = g.count;
+
+    std::string file_name = amrex::Concatenate(m_dir + "/Level_", lev, 1) + "/";
+    file_name = NFilesIter::FileName(g.which, file_name + ParticleContainerBase::DataPrefix());
+    std::ifstream ifs(file_name, std::ios::in | std::ios::binary);
+    if (!ifs.good()) { amrex::FileOpenFailed(file_name); }
+
+    const particle_detail::ColumnarGridLayout layout(g.where, n, 2 + int(m_int_names.size()),
+                                                     m_real_size);
+
+    std::array<Vector<ParticleReal>, AMREX_SPACEDIM> pos;
+    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+        readRealColumn(ifs, layout.realOffset(d), n, m_real_size, pos[d]);
+    }
+
+    Vector<Long> keep;
+    keep.reserve(n);
+    for (Long i = 0; i < n; ++i) {
+        ParticleReal p[AMREX_SPACEDIM] = {AMREX_D_DECL(pos[0][i], pos[1][i], pos[2][i])};
+        if (subset.contains(p)) { keep.push_back(i); }
+    }
+    if (keep.empty()) { return; }
+
+    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+        for (auto i : keep) { data.pos[d].push_back(pos[d][i]); }
+    }
+
+    Vector<int> id0, id1;
+    readColumn(ifs, layout.intOffset(0), n, id0);
+    readColumn(ifs, layout.intOffset(1), n, id1);
+    for (auto i : keep) {
+        if (m_is_checkpoint) {
+            std::uint32_t xu, yu;
+            std::memcpy(&xu, &id0[i], sizeof(xu));
+            std::memcpy(&yu, &id1[i], sizeof(yu));
+            std::uint64_t idcpu = (std::uint64_t(xu) << 32) | yu;
+            data.id.push_back(Long(ParticleIDWrapper(idcpu)));
+            data.cpu.push_back(int(ParticleCPUWrapper(idcpu)));
+        } else {
+            data.id.push_back(id0[i]);
+            data.cpu.push_back(id1[i]);
+        }
+    }
+
+    Vector<int> icol;
+    for (int k = 0; k < int_comps.size(); ++k) {
+        readColumn(ifs, layout.intOffset(2 + int_comps[k]), n, icol);
+        for (auto i : keep) { data.int_data[k].push_back(icol[i]); }
+    }
+
+    Vector<ParticleReal> rcol;
+    for (int k = 0; k < real_comps.size(); ++k) {
+        readRealColumn(ifs, layout.realOffset(AMREX_SPACEDIM + real_comps[k]), n,
+                       m_real_size, rcol);
+        for (auto i : keep) { data.real_data[k].push_back(rcol[i]); }
+    }
+}
+
+}
@@ -1,4 +1,5 @@
 #include <AMReX_ParticleCommunication.H>
+#include <AMReX_ParticleMPIUtil.H>
 #include <AMReX_ParallelDescriptor.H>
 
 using namespace amrex;
@@ -257,6 +258,9 @@ void ParticleCopyPlan::doHandShake (const Vector<Long>& Snds, Vector<Long>& Rcvs
 {
     BL_PROFILE("ParticleCopyPlan::doHandShake");
     if (m_local) { doHandShakeLocal(Snds, Rcvs); }
+    else if (ParallelContext::NProcsSub() >= NBXHandShakeMinProcs()) {
+        doHandShakeNBX(Snds, Rcvs);
+    }
     else         { doHandShakeGlobal(Snds, Rcvs); }
 }
 
@@ -368,6 +372,33 @@ void ParticleCopyPlan::doHandShakeGlobal (const Vector<Long>& Snds, Vector<Long>
 #endif
 }
 
+void ParticleCopyPlan::doHandShakeNBX (const Vector<Long>& Snds, Vector<Long>& Rcvs)
+{
+#ifdef AMREX_USE_MPI
+    const int NProcs = ParallelContext::NProcsSub();
+
+    Vector<int> snd_procs, rcv_procs;
+    Vector<Long> snd_data, rcv_data;
+    for (int i = 0; i < NProcs; ++i)
+    {
+        if (Snds[i] == 0) { continue; }
+        snd_procs.push_back(i);
+        snd_data.push_back(Snds[i]);
+    }
+
+    ParallelDescriptor::SparseHandShake(snd_procs, snd_data, rcv_procs, rcv_data,
+                                        ParallelDescriptor::SeqNum(),
+                                        ParallelContext::CommunicatorSub());
+
+    for (int i = 0; i < static_cast<int>(rcv_procs.size()); ++i)
+    {
+        Rcvs[rcv_procs[i]] = rcv_data[i];
+    }
+#else
+    amrex::ignore_unused(Snds,Rcvs);
+#endif
+}
+
 void amrex::communicateParticlesFinish (const ParticleCopyPlan& plan)
 {
     BL_PROFILE("amrex::communicateParticlesFinish");
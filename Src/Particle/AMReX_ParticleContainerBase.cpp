@@ -177,6 +177,17 @@ const std::string& ParticleContainerBase::PlotfileVersion ()
     return plotfile_version;
 }
 
+const std::string& ParticleContainerBase::ColumnarVersion ()
+{
+    //
+    // The columnar format (particles.columnar_io = 1) is used for both
+    // checkpoints and plotfiles; the Header records which one it is.
+    //
+    static const std::string columnar_version("Version_Columnar_One_Dot_Zero");
+
+    return columnar_version;
+}
+
 const std::string& ParticleContainerBase::DataPrefix ()
 {
     //
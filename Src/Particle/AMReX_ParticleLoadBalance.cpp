@@ -0,0 +1,51 @@
+#include <AMReX_ParticleLoadBalance.H>
+#include <AMReX_ParallelDescriptor.H>
+
+#include <array>
+
+using namespace amrex;
+
+MeshParticleCostModel::MeshParticleCostModel (Real a_mesh_weight, Real a_particle_weight,
+                                              Real a_smoothing)
+    : m_mesh_weight(a_mesh_weight),
+      m_particle_weight(a_particle_weight),
+      m_smoothing(a_smoothing)
+{
+    AMREX_ALWAYS_ASSERT(a_mesh_weight >= Real(0.0) && a_particle_weight >= Real(0.0));
+    AMREX_ALWAYS_ASSERT(a_smoothing >= Real(0.0) && a_smoothing < Real(1.0));
+}
+
+bool MeshParticleCostModel::calibrate ()
+{
+    BL_PROFILE("MeshParticleCostModel::calibrate");
+
+    std::array<Real, 4> sums{m_mesh_time, static_cast<Real>(m_mesh_count),
+                             m_particle_time, static_cast<Real>(m_particle_count)};
+    ParallelDescriptor::ReduceRealSum(sums.data(), static_cast<int>(sums.size()));
+
+    m_mesh_time = Real(0.0);
+    m_particle_time = Real(0.0);
+    m_mesh_count = 0;
+    m_particle_count = 0;
+
+    if (sums[0] <= Real(0.0) || sums[1] <= Real(0.0) ||
+        sums[2] <= Real(0.0) || sums[3] <= Real(0.0)) {
+        return false;
+    }
+
+    Real mesh_weight = sums[0] / sums[1];
+    Real particle_weight = sums[2] / sums[3];
+
+    // The initial weights are in arbitrary units, so the first measurement
+    // replaces them instead of being blended with them.
+    if (m_calibrated) {
+        m_mesh_weight = m_smoothing*m_mesh_weight + (Real(1.0)-m_smoothing)*mesh_weight;
+        m_particle_weight = m_smoothing*m_particle_weight + (Real(1.0)-m_smoothing)*particle_weight;
+    } else {
+        m_mesh_weight = mesh_weight;
+        m_particle_weight = particle_weight;
+        m_calibrated = true;
+    }
+
+    return true;
+}
@@ -3,9 +3,26 @@
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParallelReduce.H>
 #include <AMReX_BLProfiler.H>
+#include <AMReX_ParmParse.H>
 
 namespace amrex {
 
+    int NBXHandShakeMinProcs ()
+    {
+        static int nbx_min_procs;
+        static bool first = true;
+
+        if (first)
+        {
+            first = false;
+            nbx_min_procs = 256;
+            ParmParse pp("particles");
+            pp.queryAdd("nbx_handshake_min_procs", nbx_min_procs);
+        }
+
+        return nbx_min_procs;
+    }
+
 #ifdef AMREX_USE_MPI
 
     Long CountSnds(const std::map<int, Vector<char> >& not_ours, Vector<Long>& Snds)
@@ -28,6 +45,25 @@ namespace amrex {
         Long NumSnds = CountSnds(not_ours, Snds);
         if (NumSnds == 0) { return NumSnds; }
 
+        if (ParallelContext::NProcsSub() >= NBXHandShakeMinProcs())
+        {
+            Vector<int> snd_procs, rcv_procs;
+            Vector<Long> snd_data, rcv_data;
+            for (const auto& kv : not_ours)
+            {
+                snd_procs.push_back(kv.first);
+                snd_data.push_back(static_cast<Long>(kv.second.size()));
+            }
+            ParallelDescriptor::SparseHandShake(snd_procs, snd_data, rcv_procs, rcv_data,
+                                                ParallelDescriptor::SeqNum(),
+                                                ParallelContext::CommunicatorSub());
+            for (int i = 0; i < static_cast<int>(rcv_procs.size()); ++i)
+            {
+                Rcvs[rcv_procs[i]] = rcv_data[i];
+            }
+            return NumSnds;
+        }
+
         BL_COMM_PROFILE(BLProfiler::Alltoall, sizeof(Long),
                         ParallelContext::MyProcSub(), BLProfiler::BeforeCall());
 
@@ -0,0 +1,118 @@
+#include <AMReX.H>
+#include <AMReX_FFT.H>
+#include <AMReX_OpenBC.H>
+#include <AMReX_OpenBC_K.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_MultiFabUtil.H>
+
+using namespace amrex;
+
+namespace {
+
+// Forward and backward transforms of random data should give back the
+// data times the number of cells.
+Real test_roundtrip (Box const& domain)
+{
+    BoxArray ba(domain);
+    ba.maxSize(16);
+    DistributionMapping dm(ba);
+    MultiFab mf(ba, dm, 1, 0);
+    MultiFab mf2(ba, dm, 1, 0);
+    FillRandom(mf, 0, 1);
+
+    FFT::R2C<Real> r2c(domain);
+    r2c.forwardThenBackward(mf, mf2, [=] AMREX_GPU_DEVICE (int, int, int, GpuComplex<Real>&) {});
+    mf2.mult(r2c.scalingFactor());
+
+    MultiFab::Subtract(mf2, mf, 0, 0, 1, 0);
+    return mf2.norminf(0) / mf.norminf(0);
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        BL_PROFILE("main");
+
+        int n_cell = 64;
+        int max_grid_size = 32;
+        Real sigma = 0.1;
+        int verbose = 1;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("sigma", sigma);
+            pp.query("verbose", verbose);
+        }
+
+        for (auto const& n : {IntVect(16,12,10), IntVect(17,9,34), IntVect(15,22,13)}) {
+            Real err = test_roundtrip(Box(IntVect(-3), n-4));
+            amrex::Print() << "  FFT round trip error for " << n << ": " << err << "\n";
+            AMREX_ALWAYS_ASSERT(err < Real(1.e-12));
+        }
+
+        // Gaussian charge at the center of [-1,1]^3
+        Box domain(IntVect(0), IntVect(n_cell-1));
+        RealBox rb({-1.,-1.,-1.}, {1.,1.,1.});
+        Geometry geom(domain, rb, CoordSys::cartesian, {0,0,0});
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        MultiFab rho(ba, dm, 1, 0);
+        MultiFab phi_exact(ba, dm, 1, 0);
+        auto const problo = geom.ProbLoArray();
+        auto const dx = geom.CellSizeArray();
+        for (MFIter mfi(rho); mfi.isValid(); ++mfi) {
+            Box const& bx = mfi.validbox();
+            auto const& r = rho.array(mfi);
+            auto const& p = phi_exact.array(mfi);
+            ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+            {
+                Real x = problo[0] + (i+Real(0.5))*dx[0];
+                Real y = problo[1] + (j+Real(0.5))*dx[1];
+                Real z = problo[2] + (k+Real(0.5))*dx[2];
+                Real rr = std::sqrt(x*x+y*y+z*z);
+                r(i,j,k) = std::exp(-rr*rr/(Real(2.)*sigma*sigma))
+                    / (std::pow(Real(2.)*Math::pi<Real>(), Real(1.5))*sigma*sigma*sigma);
+                p(i,j,k) = -std::erf(rr/(std::sqrt(Real(2.))*sigma))
+                    / (Real(4.)*Math::pi<Real>()*rr);
+            });
+        }
+
+        MultiFab phi(ba, dm, 1, 1);
+        Real const phinorm = phi_exact.norminf(0);
+
+        {
+            FFT::OpenBCSolver<Real> solver(domain);
+            solver.setGreensFunction([=] AMREX_GPU_DEVICE (int i, int j, int k)
+            {
+                return openbc::integrated_greens_function(i,j,k,dx);
+            });
+            phi.setVal(0.0);
+            solver.solve(phi, rho);
+            MultiFab::Subtract(phi, phi_exact, 0, 0, 1, 0);
+            Real err = phi.norminf(0) / phinorm;
+            amrex::Print() << "  FFT::OpenBCSolver relative error: " << err << "\n";
+            AMREX_ALWAYS_ASSERT(err < Real(1.e-2));
+        }
+
+        for (bool use_fft : {false, true}) {
+            OpenBCSolver solver({geom}, {ba}, {dm});
+            solver.setVerbose(verbose);
+            solver.useFFT(use_fft);
+            phi.setVal(0.0);
+            solver.solve({&phi}, {&rho}, Real(1.e-10), Real(0.));
+            MultiFab::Subtract(phi, phi_exact, 0, 0, 1, 0);
+            Real err = phi.norminf(0) / phinorm;
+            amrex::Print() << "  OpenBCSolver (use_fft = " << use_fft
+                           << ") relative error: " << err << "\n";
+            AMREX_ALWAYS_ASSERT(err < Real(1.e-2));
+        }
+    }
+    amrex::Finalize();
+}
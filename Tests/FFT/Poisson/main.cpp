@@ -0,0 +1,127 @@
+#include <AMReX.H>
+#include <AMReX_FFT.H>
+#include <AMReX_MLMG.H>
+#include <AMReX_MLPoisson.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+
+using namespace amrex;
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        BL_PROFILE("main");
+
+        Vector<int> n_cell{AMREX_D_DECL(64,48,30)};
+        int max_grid_size = 32;
+        std::string domain_strategy("automatic");
+        {
+            ParmParse pp;
+            pp.queryarr("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("domain_strategy", domain_strategy);
+        }
+
+        FFT::Info info{};
+        if (domain_strategy == "slab") {
+            info.setDomainStrategy(FFT::DomainStrategy::slab);
+        } else if (domain_strategy == "pencil") {
+            info.setDomainStrategy(FFT::DomainStrategy::pencil);
+        }
+
+        Box domain(IntVect(0), IntVect(AMREX_D_DECL(n_cell[0]-1,n_cell[1]-1,n_cell[2]-1)));
+        RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        Geometry geom(domain, rb, CoordSys::cartesian, {AMREX_D_DECL(1,1,1)});
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        MultiFab rhs(ba, dm, 1, 0);
+        auto const problo = geom.ProbLoArray();
+        auto const dx = geom.CellSizeArray();
+        for (MFIter mfi(rhs); mfi.isValid(); ++mfi) {
+            Box const& bx = mfi.validbox();
+            auto const& r = rhs.array(mfi);
+            ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+            {
+                constexpr Real tpi = Real(2.)*Math::pi<Real>();
+                AMREX_D_TERM(Real x = problo[0] + (i+Real(0.5))*dx[0];,
+                             Real y = problo[1] + (j+Real(0.5))*dx[1];,
+                             Real z = problo[2] + (k+Real(0.5))*dx[2]);
+                r(i,j,k) = AMREX_D_TERM(std::sin(tpi*x),
+                                        + std::cos(Real(3.)*tpi*y)*std::sin(tpi*x),
+                                        + std::exp(std::sin(tpi*z)))
+                    + Real(0.25); // nonzero mean
+            });
+        }
+
+        MultiFab soln(ba, dm, 1, 1);
+        MultiFab soln_mlmg(ba, dm, 1, 1);
+
+        FFT::Poisson<MultiFab> fft_poisson(geom, info);
+        soln.setVal(0.0);
+        fft_poisson.solve(soln, rhs);
+
+        MLPoisson mlpoisson({geom}, {ba}, {dm});
+        mlpoisson.setDomainBC({AMREX_D_DECL(LinOpBCType::Periodic,
+                                            LinOpBCType::Periodic,
+                                            LinOpBCType::Periodic)},
+                              {AMREX_D_DECL(LinOpBCType::Periodic,
+                                            LinOpBCType::Periodic,
+                                            LinOpBCType::Periodic)});
+        mlpoisson.setLevelBC(0, nullptr);
+        MLMG mlmg(mlpoisson);
+        soln_mlmg.setVal(0.0);
+        mlmg.solve({&soln_mlmg}, {&rhs}, Real(1.e-12), Real(0.));
+
+        // The periodic solution is determined up to a constant.
+        Real const npts = Real(domain.d_numPts());
+        soln.plus(-soln.sum(0)/npts, 0, 1);
+        soln_mlmg.plus(-soln_mlmg.sum(0)/npts, 0, 1);
+
+        MultiFab::Subtract(soln, soln_mlmg, 0, 0, 1, 0);
+        Real err = soln.norminf(0) / soln_mlmg.norminf(0);
+        amrex::Print() << "  FFT::Poisson vs. MLMG relative difference: " << err << "\n";
+        AMREX_ALWAYS_ASSERT(err < Real(1.e-8));
+
+        // Compare with the analytic solution of a problem with a few
+        // Fourier modes.  The error is that of the second order
+        // discretization.
+        MultiFab exact(ba, dm, 1, 0);
+        for (MFIter mfi(rhs); mfi.isValid(); ++mfi) {
+            Box const& bx = mfi.validbox();
+            auto const& r = rhs.array(mfi);
+            auto const& e = exact.array(mfi);
+            ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+            {
+                constexpr Real tpi = Real(2.)*Math::pi<Real>();
+                AMREX_D_TERM(Real x = problo[0] + (i+Real(0.5))*dx[0];,
+                             Real y = problo[1] + (j+Real(0.5))*dx[1];,
+                             Real z = problo[2] + (k+Real(0.5))*dx[2]);
+                AMREX_D_TERM(Real fx = std::sin(tpi*x);,
+                             Real fy = std::cos(Real(2.)*tpi*y);,
+                             Real fz = std::sin(tpi*z));
+                r(i,j,k) = AMREX_D_TERM(fx, + fy, + fz);
+                e(i,j,k) = AMREX_D_TERM(-fx/(tpi*tpi),
+                                        - fy/(Real(4.)*tpi*tpi),
+                                        - fz/(tpi*tpi));
+            });
+        }
+        soln.setVal(0.0);
+        fft_poisson.solve(soln, rhs);
+        soln.plus(-soln.sum(0)/npts, 0, 1);
+
+        MultiFab::Subtract(soln, exact, 0, 0, 1, 0);
+        err = soln.norminf(0) / exact.norminf(0);
+        // The relative error of mode m is about (2 pi m h)^2/12.
+        Real kh = 0;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            Real const m = (idim == 1) ? Real(2.) : Real(1.);
+            kh = std::max(kh, Real(2.)*Math::pi<Real>()*m*dx[idim]);
+        }
+        amrex::Print() << "  FFT::Poisson vs. analytic relative error: " << err << "\n";
+        AMREX_ALWAYS_ASSERT(err < kh*kh/Real(6.));
+    }
+    amrex::Finalize();
+}
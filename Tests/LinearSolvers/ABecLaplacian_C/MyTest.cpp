@@ -8,12 +8,94 @@
 #include <AMReX_ParmParse.H>
 #include <AMReX_MultiFabUtil.H>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <string>
+
 #ifdef AMREX_USE_HYPRE
 #include <AMReX_HypreMLABecLap.H>
 #endif
 
 using namespace amrex;
 
+namespace {
+    // GMRESMLMG without multiDotProduct, so that GMRES computes the
+    // Gram-Schmidt projections with one dotProduct per basis vector
+    struct UnbatchedGMRESMLMG
+    {
+        using RT = Real;
+
+        GMRESMLMG& op;
+
+        [[nodiscard]] MultiFab makeVecRHS () const { return op.makeVecRHS(); }
+        [[nodiscard]] MultiFab makeVecLHS () const { return op.makeVecLHS(); }
+        [[nodiscard]] Real norm2 (MultiFab const& mf) const { return op.norm2(mf); }
+        static void scale (MultiFab& mf, Real a) { GMRESMLMG::scale(mf, a); }
+        [[nodiscard]] Real dotProduct (MultiFab const& mf1, MultiFab const& mf2) const {
+            return op.dotProduct(mf1, mf2);
+        }
+        static void setToZero (MultiFab& lhs) { GMRESMLMG::setToZero(lhs); }
+        static void assign (MultiFab& lhs, MultiFab const& rhs) { GMRESMLMG::assign(lhs, rhs); }
+        static void increment (MultiFab& lhs, MultiFab const& rhs, Real a) {
+            GMRESMLMG::increment(lhs, rhs, a);
+        }
+        static void linComb (MultiFab& lhs, Real a, MultiFab const& rhs_a,
+                             Real b, MultiFab const& rhs_b) {
+            GMRESMLMG::linComb(lhs, a, rhs_a, b, rhs_b);
+        }
+        void apply (MultiFab& lhs, MultiFab const& rhs) const { op.apply(lhs, rhs); }
+        void precond (MultiFab& lhs, MultiFab const& rhs) const { op.precond(lhs, rhs); }
+    };
+
+    // The value of a top level integer field of MLMGTelemetry::writeJSON
+    Long json_field (std::string const& json, std::string const& key)
+    {
+        const std::string k = "\"" + key + "\": ";
+        const auto pos = json.find(k);
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(pos != std::string::npos,
+                                         ("Telemetry: no " + key + " in JSON").c_str());
+        return std::stol(json.substr(pos + k.size()));
+    }
+
+    void check_telemetry_json (MLMG const& mlmg)
+    {
+        MLMGTelemetry telemetry = mlmg.getTelemetry();
+
+        std::ostringstream oss;
+        telemetry.writeJSON(oss);
+        const std::string json = oss.str();
+        AMREX_ALWAYS_ASSERT(json_field(json, "num_iters") == mlmg.getNumIters());
+        AMREX_ALWAYS_ASSERT(json_field(json, "num_fill_boundary") == telemetry.num_fill_boundary);
+        AMREX_ALWAYS_ASSERT(json_field(json, "num_reductions") == telemetry.num_reductions);
+        AMREX_ALWAYS_ASSERT(telemetry.num_fill_boundary > 0 && telemetry.num_reductions > 0);
+        AMREX_ALWAYS_ASSERT(json.find("\"communication\": ") != std::string::npos);
+        AMREX_ALWAYS_ASSERT(json.front() == '{' && json.find_last_not_of('\n') == json.rfind('}'));
+
+        auto total_time = telemetry.totalTime();
+        AMREX_ALWAYS_ASSERT(std::all_of(total_time.begin(), total_time.end(),
+                                        [] (double t) { return t >= 0.0; }));
+        if (ParallelDescriptor::NProcs() > 1) {
+            AMREX_ALWAYS_ASSERT(total_time[MLMGTelemetry::communication] > 0.0);
+        }
+
+        // A diverged solve has non-finite residuals, which are written as
+        // null.
+        telemetry.final_residual = std::numeric_limits<double>::quiet_NaN();
+        telemetry.residual_history.push_back(std::numeric_limits<double>::infinity());
+        oss.str(std::string());
+        telemetry.writeJSON(oss);
+        const std::string json_nan = oss.str();
+        AMREX_ALWAYS_ASSERT(json_nan.find("\"final_residual\": null,") != std::string::npos);
+        AMREX_ALWAYS_ASSERT(json_nan.find(", null],") != std::string::npos);
+        AMREX_ALWAYS_ASSERT(json_nan.find("nan") == std::string::npos &&
+                            json_nan.find("inf") == std::string::npos);
+
+        amrex::Print() << "Telemetry JSON checked\n";
+    }
+}
+
 MyTest::MyTest ()
 {
     readParameters();
@@ -30,10 +112,18 @@ MyTest::solve ()
     }
 #endif
 
-    if (prob_type == 1) {
+    if (compare_temporal_blocking) {
+        compareTemporalBlocking();
+    } else if (compare_solver_options) {
+        compareSolverOptions();
+    } else if (prob_type == 1) {
         solvePoisson();
     } else if (prob_type == 2) {
-        if (use_gmres) {
+        if (componentwise_ncomp > 1) {
+            solveABecLaplacianComponentwise();
+        } else if (solution_history_size > 0) {
+            solveABecLaplacianSequence();
+        } else if (use_gmres) {
             solveABecLaplacianGMRES();
         } else {
             solveABecLaplacian();
@@ -65,6 +155,7 @@ MyTest::solvePoisson ()
         MLPoisson mlpoisson(geom, grids, dmap, info);
 
         mlpoisson.setGaussSeidel(use_gauss_seidel);
+        if (use_chebyshev) { mlpoisson.setSmoother(MLSmoother::chebyshev); }
 
         mlpoisson.setMaxOrder(linop_maxorder);
 
@@ -107,6 +198,7 @@ MyTest::solvePoisson ()
             MLPoisson mlpoisson({geom[ilev]}, {grids[ilev]}, {dmap[ilev]}, info);
 
             mlpoisson.setGaussSeidel(use_gauss_seidel);
+            if (use_chebyshev) { mlpoisson.setSmoother(MLSmoother::chebyshev); }
 
             mlpoisson.setMaxOrder(linop_maxorder);
 
@@ -167,6 +259,8 @@ MyTest::solveABecLaplacian ()
         MLABecLaplacian mlabec(geom, grids, dmap, info);
 
         mlabec.setGaussSeidel(use_gauss_seidel);
+        if (use_chebyshev) { mlabec.setSmoother(MLSmoother::chebyshev); }
+        if (line_relaxation_dir >= 0) { mlabec.setLineRelaxation(line_relaxation_dir); }
 
         mlabec.setMaxOrder(linop_maxorder);
 
@@ -209,6 +303,7 @@ MyTest::solveABecLaplacian ()
         if (use_hypre) {
             mlmg.setBottomSolver(MLMG::BottomSolver::hypre);
             mlmg.setHypreInterface(hypre_interface);
+            mlmg.setHypreMaxSetupReuse(hypre_max_setup_reuse);
         }
 #endif
 #ifdef AMREX_USE_PETSC
@@ -217,7 +312,53 @@ MyTest::solveABecLaplacian ()
         }
 #endif
 
+        if (check_telemetry) { mlmg.setTelemetry(true); }
+
         mlmg.solve(GetVecOfPtrs(solution), GetVecOfConstPtrs(rhs), tol_rel, tol_abs);
+
+        if (check_telemetry) { check_telemetry_json(mlmg); }
+
+#ifdef AMREX_USE_HYPRE
+        if (use_hypre && hypre_max_setup_reuse > 0)
+        {
+            // Change the coefficients and solve again.  The hypre matrix is
+            // updated in place and the hypre setup done for the old
+            // coefficients is reused.  The result must agree with a solve by
+            // a new MLMG, which builds its hypre solver from scratch.
+            for (int ilev = 0; ilev < nlevels; ++ilev) {
+                MultiFab new_acoef(acoef[ilev].boxArray(), acoef[ilev].DistributionMap(), 1, 0);
+                MultiFab::Copy(new_acoef, acoef[ilev], 0, 0, 1, 0);
+                new_acoef.mult(Real(10.0));
+                mlabec.setACoeffs(ilev, new_acoef);
+            }
+            mlabec.setScalars(std::max(ascalar, Real(1.0)), bscalar);
+
+            mlmg.solve(GetVecOfPtrs(solution), GetVecOfConstPtrs(rhs), tol_rel, tol_abs);
+
+            Vector<MultiFab> soln_ref(nlevels);
+            for (int ilev = 0; ilev < nlevels; ++ilev) {
+                soln_ref[ilev].define(grids[ilev], dmap[ilev], 1, 1);
+                MultiFab::Copy(soln_ref[ilev], solution[ilev], 0, 0, 1, 1);
+                soln_ref[ilev].setVal(0.0, 0, 1, 0);
+            }
+            MLMG mlmg_ref(mlabec);
+            mlmg_ref.setMaxIter(max_iter);
+            mlmg_ref.setMaxFmgIter(max_fmg_iter);
+            mlmg_ref.setVerbose(verbose);
+            mlmg_ref.setBottomSolver(MLMG::BottomSolver::hypre);
+            mlmg_ref.setHypreInterface(hypre_interface);
+            mlmg_ref.solve(GetVecOfPtrs(soln_ref), GetVecOfConstPtrs(rhs), tol_rel, tol_abs);
+
+            for (int ilev = 0; ilev < nlevels; ++ilev) {
+                MultiFab::Subtract(soln_ref[ilev], solution[ilev], 0, 0, 1, 0);
+                const Real diff = soln_ref[ilev].norminf(0);
+                const Real solnorm = solution[ilev].norminf(0);
+                amrex::Print() << "Level " << ilev << ": max difference from a new hypre setup "
+                               << diff << "\n";
+                AMREX_ALWAYS_ASSERT(diff <= Real(1.e-6)*solnorm);
+            }
+        }
+#endif
     }
     else
     {
@@ -226,6 +367,8 @@ MyTest::solveABecLaplacian ()
             MLABecLaplacian mlabec({geom[ilev]}, {grids[ilev]}, {dmap[ilev]}, info);
 
             mlabec.setGaussSeidel(use_gauss_seidel);
+            if (use_chebyshev) { mlabec.setSmoother(MLSmoother::chebyshev); }
+            if (line_relaxation_dir >= 0) { mlabec.setLineRelaxation(line_relaxation_dir); }
 
             mlabec.setMaxOrder(linop_maxorder);
 
@@ -298,6 +441,8 @@ MyTest::solveABecLaplacianInhomNeumann ()
         MLABecLaplacian mlabec(geom, grids, dmap, info);
 
         mlabec.setGaussSeidel(use_gauss_seidel);
+        if (use_chebyshev) { mlabec.setSmoother(MLSmoother::chebyshev); }
+        if (line_relaxation_dir >= 0) { mlabec.setLineRelaxation(line_relaxation_dir); }
 
         mlabec.setMaxOrder(linop_maxorder);
 
@@ -359,6 +504,8 @@ MyTest::solveABecLaplacianInhomNeumann ()
             MLABecLaplacian mlabec({geom[ilev]}, {grids[ilev]}, {dmap[ilev]}, info);
 
             mlabec.setGaussSeidel(use_gauss_seidel);
+            if (use_chebyshev) { mlabec.setSmoother(MLSmoother::chebyshev); }
+            if (line_relaxation_dir >= 0) { mlabec.setLineRelaxation(line_relaxation_dir); }
 
             mlabec.setMaxOrder(linop_maxorder);
 
@@ -519,8 +666,45 @@ MyTest::solveABecLaplacianGMRES ()
         GMRESMLMG gmsolver(mlmg);
         gmsolver.usePrecond(true);
         gmsolver.setVerbose(verbose);
+
+        MultiFab sol_unbatched;
+        if (gmres_compare_unbatched) {
+            sol_unbatched.define(solution[ilev].boxArray(), solution[ilev].DistributionMap(), 1,
+                                 solution[ilev].nGrowVect());
+            MultiFab::Copy(sol_unbatched, solution[ilev], 0, 0, 1, solution[ilev].nGrowVect());
+        }
+
         gmsolver.solve(solution[ilev], rhs[ilev], tol_rel, tol_abs);
 
+        if (gmres_compare_unbatched) {
+            static_assert(IsDetected<detail::GMRESMultiDotProduct_t,
+                                     GMRESMLMG, MultiFab, Real>::value);
+            static_assert(!IsDetected<detail::GMRESMultiDotProduct_t,
+                                      UnbatchedGMRESMLMG, MultiFab, Real>::value);
+
+            // Same steps as GMRESMLMG::solve
+            UnbatchedGMRESMLMG op{gmsolver};
+            GMRES<MultiFab,UnbatchedGMRESMLMG> gmres;
+            gmres.define(op);
+            gmres.setVerbose(verbose);
+            auto res = op.makeVecRHS();
+            mlmg.apply({&res}, {&sol_unbatched}); // res = L(sol)
+            op.increment(res, rhs[ilev], Real(-1.0)); // res = L(sol) - rhs
+            auto cor = op.makeVecLHS();
+            mlabec.setDirichletNodesToZero(0, 0, res);
+            gmres.solve(cor, res, tol_rel, tol_abs);
+            op.increment(sol_unbatched, cor, Real(-1.0));
+
+            MultiFab::Subtract(sol_unbatched, solution[ilev], 0, 0, 1, 0);
+            const auto diff = sol_unbatched.norminf(0);
+            const auto solnorm = solution[ilev].norminf(0);
+            amrex::Print() << "GMRES iterations: batched " << gmsolver.getNumIters()
+                           << ", unbatched " << gmres.getNumIters()
+                           << ", max difference of the solutions " << diff << '\n';
+            AMREX_ALWAYS_ASSERT(gmres.getNumIters() == gmsolver.getNumIters());
+            AMREX_ALWAYS_ASSERT(diff <= Real(1.e-8)*solnorm);
+        }
+
         if (verbose) {
             MultiFab res(rhs[ilev].boxArray(), rhs[ilev].DistributionMap(), 1, 0);
             mlmg.apply({&res}, {&solution[ilev]}); // res = L(sol)
@@ -531,6 +715,439 @@ MyTest::solveABecLaplacianGMRES ()
     }
 }
 
+void
+MyTest::solveABecLaplacianComponentwise ()
+{
+    LPInfo info;
+    info.setAgglomeration(agglomeration);
+    info.setConsolidation(consolidation);
+    info.setMaxCoarseningLevel(max_coarsening_level);
+
+    const auto tol_rel = Real(1.e-10);
+    const auto tol_abs = Real(0.0);
+
+    const int ncomp = componentwise_ncomp;
+
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(max_level == 0,
+       "solveABecLaplacianComponentwise: only single level is supported");
+
+    // Component n solves the problem scaled by 10^n, and the odd components
+    // start from the exact solution.  A solve converged in the max norm over
+    // all components would leave the small components under-resolved.
+    MultiFab sol(grids[0], dmap[0], ncomp, 1);
+    MultiFab rhsn(grids[0], dmap[0], ncomp, 0);
+    for (int n = 0; n < ncomp; ++n) {
+        const auto scale = std::pow(Real(10.0), n);
+        MultiFab::Copy(sol, solution[0], 0, n, 1, 1);
+        if (n % 2 == 1) {
+            MultiFab::Copy(sol, exact_solution[0], 0, n, 1, 0);
+        }
+        sol.mult(scale, n, 1, 1);
+        MultiFab::Copy(rhsn, rhs[0], 0, n, 1, 0);
+        rhsn.mult(scale, n, 1, 0);
+    }
+
+    MLABecLaplacian mlabec({geom[0]}, {grids[0]}, {dmap[0]}, info, {}, ncomp);
+
+    mlabec.setGaussSeidel(use_gauss_seidel);
+    mlabec.setMaxOrder(linop_maxorder);
+
+    mlabec.setDomainBC({AMREX_D_DECL(LinOpBCType::Dirichlet,
+                                     LinOpBCType::Neumann,
+                                     LinOpBCType::Neumann)},
+                       {AMREX_D_DECL(LinOpBCType::Neumann,
+                                     LinOpBCType::Dirichlet,
+                                     LinOpBCType::Neumann)});
+
+    mlabec.setLevelBC(0, &sol);
+
+    mlabec.setScalars(ascalar, bscalar);
+
+    mlabec.setACoeffs(0, acoef[0]);
+
+    Array<MultiFab,AMREX_SPACEDIM> face_bcoef;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+    {
+        const BoxArray& ba = amrex::convert(bcoef[0].boxArray(),
+                                            IntVect::TheDimensionVector(idim));
+        face_bcoef[idim].define(ba, bcoef[0].DistributionMap(), 1, 0);
+    }
+    amrex::average_cellcenter_to_face(GetArrOfPtrs(face_bcoef), bcoef[0], geom[0]);
+    mlabec.setBCoeffs(0, amrex::GetArrOfConstPtrs(face_bcoef));
+
+    MLMG mlmg(mlabec);
+    mlmg.setMaxIter(max_iter);
+    mlmg.setMaxFmgIter(max_fmg_iter);
+    mlmg.setVerbose(verbose);
+    mlmg.setBottomVerbose(bottom_verbose);
+    mlmg.setComponentwiseConvergence(1);
+
+    mlmg.solve({&sol}, {&rhsn}, tol_rel, tol_abs);
+
+    auto const& niters_comp = mlmg.getNumItersComp();
+    auto const& init_res = mlmg.getInitResidualComp();
+    AMREX_ALWAYS_ASSERT(static_cast<int>(niters_comp.size()) == ncomp);
+
+    // Check each component against its own target with a residual computed
+    // from scratch.
+    MultiFab res(grids[0], dmap[0], ncomp, 0);
+    mlmg.apply({&res}, {&sol});
+    MultiFab::Subtract(res, rhsn, 0, 0, ncomp, 0);
+    for (int n = 0; n < ncomp; ++n) {
+        const auto rhsnorm = rhsn.norminf(n);
+        const auto resnorm = res.norminf(n);
+        const auto target = tol_rel * std::max(rhsnorm, init_res[n]);
+        amrex::Print() << "Component " << n << ": " << niters_comp[n]
+                       << " iterations, resid/target = " << resnorm/target << '\n';
+        AMREX_ALWAYS_ASSERT(niters_comp[n] > 0 && niters_comp[n] <= mlmg.getNumIters());
+        AMREX_ALWAYS_ASSERT(resnorm <= Real(1.01)*target);
+    }
+    // The solve stops as soon as the last component has converged.
+    AMREX_ALWAYS_ASSERT(*std::max_element(niters_comp.begin(), niters_comp.end())
+                        == mlmg.getNumIters());
+
+    MultiFab::Copy(solution[0], sol, 0, 0, 1, 0);
+}
+
+void
+MyTest::solveABecLaplacianSequence ()
+{
+    LPInfo info;
+    info.setAgglomeration(agglomeration);
+    info.setConsolidation(consolidation);
+    info.setMaxCoarseningLevel(max_coarsening_level);
+
+    const auto tol_rel = Real(1.e-10);
+    const auto tol_abs = Real(0.0);
+
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(max_level == 0,
+       "solveABecLaplacianSequence: only single level is supported");
+
+    Array<MultiFab,AMREX_SPACEDIM> face_bcoef;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+    {
+        const BoxArray& ba = amrex::convert(bcoef[0].boxArray(),
+                                            IntVect::TheDimensionVector(idim));
+        face_bcoef[idim].define(ba, bcoef[0].DistributionMap(), 1, 0);
+    }
+    amrex::average_cellcenter_to_face(GetArrOfPtrs(face_bcoef), bcoef[0], geom[0]);
+
+    MultiFab sol(grids[0], dmap[0], 1, 1);
+    MultiFab rhsk(grids[0], dmap[0], 1, 0);
+    MultiFab sol0(grids[0], dmap[0], 1, 0); // solution of the unscaled problem
+
+    // Solve the sequence with a history of the given size and return the
+    // number of iterations of each solve.  The rhs, the boundary values
+    // and the a coefficient change from one solve to the next, as they
+    // would in time steps, and every solve starts from the boundary data.
+    auto solve_sequence = [&] (int history_size)
+    {
+        MLABecLaplacian mlabec({geom[0]}, {grids[0]}, {dmap[0]}, info);
+
+        mlabec.setGaussSeidel(use_gauss_seidel);
+        mlabec.setMaxOrder(linop_maxorder);
+
+        mlabec.setDomainBC({AMREX_D_DECL(LinOpBCType::Dirichlet,
+                                         LinOpBCType::Neumann,
+                                         LinOpBCType::Neumann)},
+                           {AMREX_D_DECL(LinOpBCType::Neumann,
+                                         LinOpBCType::Dirichlet,
+                                         LinOpBCType::Neumann)});
+
+        mlabec.setACoeffs(0, acoef[0]);
+        mlabec.setBCoeffs(0, amrex::GetArrOfConstPtrs(face_bcoef));
+
+        MLMG mlmg(mlabec);
+        mlmg.setMaxIter(max_iter);
+        mlmg.setMaxFmgIter(max_fmg_iter);
+        mlmg.setVerbose(verbose);
+        mlmg.setBottomVerbose(bottom_verbose);
+        mlmg.setSolutionHistorySize(history_size);
+
+        Vector<int> niters;
+        for (int k = 0; k < num_solves; ++k) {
+            const auto scale = Real(1.0) + Real(0.25)*Real(k);
+            MultiFab::Copy(sol, solution[0], 0, 0, 1, 1);
+            sol.mult(scale, 0, 1, 1);
+            MultiFab::Copy(rhsk, rhs[0], 0, 0, 1, 0);
+            rhsk.mult(scale, 0, 1, 0);
+
+            mlabec.setScalars(ascalar*scale, bscalar);
+            mlabec.setLevelBC(0, &sol);
+
+            mlmg.solve({&sol}, {&rhsk}, tol_rel, tol_abs);
+            niters.push_back(mlmg.getNumIters());
+            if (k == 0) { MultiFab::Copy(sol0, sol, 0, 0, 1, 0); }
+        }
+        return niters;
+    };
+
+    auto const niters_plain = solve_sequence(0);
+    auto const niters_hist = solve_sequence(solution_history_size);
+
+    int total_plain = 0;
+    int total_hist = 0;
+    for (int k = 0; k < num_solves; ++k) {
+        amrex::Print() << "Solve " << k << ": " << niters_plain[k] << " iterations without and "
+                       << niters_hist[k] << " with the solution history\n";
+        total_plain += niters_plain[k];
+        total_hist += niters_hist[k];
+        // The first solve has no history yet.
+        if (k == 0) {
+            AMREX_ALWAYS_ASSERT(niters_hist[k] == niters_plain[k]);
+        } else {
+            AMREX_ALWAYS_ASSERT(niters_hist[k] <= niters_plain[k]);
+        }
+    }
+    AMREX_ALWAYS_ASSERT(num_solves < 2 || total_hist < total_plain);
+
+    MultiFab::Copy(solution[0], sol0, 0, 0, 1, 0);
+}
+
+void
+MyTest::compareTemporalBlocking ()
+{
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(max_level == 0,
+       "compareTemporalBlocking: only single level is supported");
+
+    LPInfo info;
+    info.setAgglomeration(agglomeration);
+    info.setConsolidation(consolidation);
+    info.setMaxCoarseningLevel(max_coarsening_level);
+
+    const int niters = 3;
+
+    for (int box_size : tb_box_sizes) {
+        BoxArray ba(geom[0].Domain());
+        ba.maxSize(box_size);
+        DistributionMapping dm(ba);
+
+        // The ghost cells of the initial guess have the Dirichlet values.
+        MultiFab sol0(ba, dm, 1, 1);
+        sol0.ParallelCopy(solution[0], 0, 0, 1, IntVect(1), IntVect(1));
+        MultiFab rhsb(ba, dm, 1, 0);
+        rhsb.ParallelCopy(rhs[0]);
+
+        Array<MultiFab,AMREX_SPACEDIM> face_bcoef;
+        MultiFab acoefb;
+        if (prob_type == 2) {
+            acoefb.define(ba, dm, 1, 0);
+            acoefb.ParallelCopy(acoef[0]);
+            MultiFab bcoefb(ba, dm, 1, 1);
+            bcoefb.ParallelCopy(bcoef[0], 0, 0, 1, IntVect(1), IntVect(1));
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                face_bcoef[idim].define(amrex::convert(ba, IntVect::TheDimensionVector(idim)),
+                                        dm, 1, 0);
+            }
+            amrex::average_cellcenter_to_face(GetArrOfPtrs(face_bcoef), bcoefb, geom[0]);
+        }
+
+        for (int nsweeps : tb_nsweeps) {
+            Array<MultiFab,2> result;
+            for (int blocked = 0; blocked < 2; ++blocked) {
+                auto& sol = result[blocked];
+                sol.define(ba, dm, 1, 1);
+                MultiFab::Copy(sol, sol0, 0, 0, 1, 1);
+
+                std::unique_ptr<MLCellLinOp> linop;
+                if (prob_type == 1) {
+                    auto p = std::make_unique<MLPoisson>(Vector<Geometry>{geom[0]},
+                                                         Vector<BoxArray>{ba},
+                                                         Vector<DistributionMapping>{dm},
+                                                         info);
+                    p->setDomainBC({AMREX_D_DECL(LinOpBCType::Dirichlet,
+                                                 LinOpBCType::Dirichlet,
+                                                 LinOpBCType::Dirichlet)},
+                                   {AMREX_D_DECL(LinOpBCType::Dirichlet,
+                                                 LinOpBCType::Dirichlet,
+                                                 LinOpBCType::Dirichlet)});
+                    linop = std::move(p);
+                } else {
+                    auto p = std::make_unique<MLABecLaplacian>(Vector<Geometry>{geom[0]},
+                                                               Vector<BoxArray>{ba},
+                                                               Vector<DistributionMapping>{dm},
+                                                               info);
+                    p->setDomainBC({AMREX_D_DECL(LinOpBCType::Dirichlet,
+                                                 LinOpBCType::Neumann,
+                                                 LinOpBCType::Neumann)},
+                                   {AMREX_D_DECL(LinOpBCType::Neumann,
+                                                 LinOpBCType::Dirichlet,
+                                                 LinOpBCType::Neumann)});
+                    p->setScalars(ascalar, bscalar);
+                    p->setACoeffs(0, acoefb);
+                    p->setBCoeffs(0, amrex::GetArrOfConstPtrs(face_bcoef));
+                    linop = std::move(p);
+                }
+                linop->setMaxOrder(linop_maxorder);
+                linop->setLevelBC(0, &sol);
+                linop->setTemporalBlocking(blocked);
+
+                MLMG mlmg(*linop);
+                mlmg.setFixedIter(niters);
+                mlmg.setPreSmooth(nsweeps);
+                mlmg.setPostSmooth(nsweeps);
+                mlmg.setVerbose(0);
+                mlmg.solve({&sol}, {&rhsb}, Real(1.e-10), Real(0.0));
+            }
+
+            MultiFab::Subtract(result[1], result[0], 0, 0, 1, 0);
+            const auto diff = result[1].norminf(0);
+            amrex::Print() << "Temporal blocking: box size " << box_size << ", " << nsweeps
+                           << " sweeps: max difference " << diff << '\n';
+            AMREX_ALWAYS_ASSERT(diff == Real(0.0));
+
+            if (box_size == tb_box_sizes.back() && nsweeps == tb_nsweeps.back()) {
+                solution[0].ParallelCopy(result[0]);
+            }
+        }
+    }
+}
+
+int
+MyTest::solveABecLaplacianWith (SolverOptions const& options, MultiFab& soln,
+                                bool must_converge)
+{
+    LPInfo info;
+    info.setAgglomeration(agglomeration);
+    info.setConsolidation(consolidation);
+    info.setMaxCoarseningLevel(max_coarsening_level);
+
+    const auto tol_rel = Real(1.e-10);
+    const auto tol_abs = Real(0.0);
+
+    MLABecLaplacian mlabec({geom[0]}, {grids[0]}, {dmap[0]}, info);
+
+    if (options.line_relaxation_dir >= 0) {
+        mlabec.setLineRelaxation(options.line_relaxation_dir);
+    }
+    if (options.plane_relaxation_dir >= 0) {
+        mlabec.setPlaneRelaxation(options.plane_relaxation_dir);
+    }
+
+    mlabec.setMaxOrder(linop_maxorder);
+
+    mlabec.setDomainBC({AMREX_D_DECL(LinOpBCType::Dirichlet,
+                                     LinOpBCType::Neumann,
+                                     LinOpBCType::Neumann)},
+                       {AMREX_D_DECL(LinOpBCType::Neumann,
+                                     LinOpBCType::Dirichlet,
+                                     LinOpBCType::Neumann)});
+
+    mlabec.setLevelBC(0, &soln);
+
+    mlabec.setScalars(ascalar, bscalar);
+
+    mlabec.setACoeffs(0, acoef[0]);
+
+    Array<MultiFab,AMREX_SPACEDIM> face_bcoef;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+    {
+        const BoxArray& ba = amrex::convert(bcoef[0].boxArray(),
+                                            IntVect::TheDimensionVector(idim));
+        face_bcoef[idim].define(ba, bcoef[0].DistributionMap(), 1, 0);
+    }
+    amrex::average_cellcenter_to_face(GetArrOfPtrs(face_bcoef), bcoef[0], geom[0]);
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        face_bcoef[idim].mult(bcoef_scale[idim]);
+    }
+    mlabec.setBCoeffs(0, amrex::GetArrOfConstPtrs(face_bcoef));
+
+    MLMG mlmg(mlabec);
+    mlmg.setMaxIter(max_iter);
+    mlmg.setVerbose(verbose);
+    mlmg.setBottomVerbose(bottom_verbose);
+    mlmg.setBottomSolver(options.bottom_solver);
+    mlmg.setAMGGatherMaxCells(options.amg_gather_max_cells);
+
+    if (must_converge) {
+        mlmg.solve({&soln}, {&rhs[0]}, tol_rel, tol_abs);
+    } else {
+        mlmg.setThrowException(true);
+        try {
+            mlmg.solve({&soln}, {&rhs[0]}, tol_rel, tol_abs);
+        } catch (MLMG::error const&) {
+            return -1;
+        }
+    }
+
+    AMREX_ALWAYS_ASSERT(mlmg.getFinalResidual() <=
+                        tol_rel * std::max(mlmg.getInitRHS(), mlmg.getInitResidual()));
+
+    return mlmg.getNumIters();
+}
+
+void
+MyTest::compareSolverOptions ()
+{
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(max_level == 0,
+       "compareSolverOptions: only single level is supported");
+
+    SolverOptions options;
+    options.bottom_solver = bottom_solver;
+    options.amg_gather_max_cells = amg_gather_max_cells;
+    options.line_relaxation_dir = line_relaxation_dir;
+    options.plane_relaxation_dir = plane_relaxation_dir;
+
+    const bool relaxation = line_relaxation_dir >= 0 || plane_relaxation_dir >= 0;
+    SolverOptions ref_options = options;
+    if (relaxation) {
+        ref_options.line_relaxation_dir = -1;
+        ref_options.plane_relaxation_dir = -1;
+    } else if (amg_gather_max_cells > 0) {
+        ref_options.amg_gather_max_cells = 0;
+    } else {
+        ref_options.bottom_solver = MLMG::BottomSolver::Default;
+    }
+
+    // The ghost cells of the initial guess have the Dirichlet values.
+    MultiFab ref_soln(grids[0], dmap[0], 1, 1);
+    MultiFab::Copy(ref_soln, solution[0], 0, 0, 1, 1);
+    // With strong anisotropy, the point smoother may not converge at all.
+    const int ref_niters = solveABecLaplacianWith(ref_options, ref_soln, !relaxation);
+    const int niters = solveABecLaplacianWith(options, solution[0]);
+
+    amrex::Print() << "Solver options: " << niters << " iterations vs "
+                   << ref_niters << " for the reference\n";
+
+    if (ref_niters < 0) {
+        amrex::Print() << "Solver options: the reference solve failed\n";
+        return;
+    }
+
+    if (relaxation) {
+        AMREX_ALWAYS_ASSERT(niters < ref_niters);
+    }
+
+    const Real solnorm = ref_soln.norminf(0);
+
+    // Without anisotropy, the solution is that of the analytic problem.
+    const bool isotropic = bcoef_scale == Vector<Real>(AMREX_SPACEDIM, Real(1.0));
+    Real ref_error = Real(0.0);
+    if (isotropic) {
+        MultiFab err(grids[0], dmap[0], 1, 0);
+        MultiFab::Copy(err, ref_soln, 0, 0, 1, 0);
+        MultiFab::Subtract(err, exact_solution[0], 0, 0, 1, 0);
+        ref_error = err.norminf(0);
+    }
+
+    MultiFab::Subtract(ref_soln, solution[0], 0, 0, 1, 0);
+    const Real diff = ref_soln.norminf(0);
+    amrex::Print() << "Solver options: max difference from the reference "
+                   << diff << " (max norm of the solution " << solnorm << ")\n";
+    AMREX_ALWAYS_ASSERT(diff <= Real(1.e-6) * solnorm);
+
+    if (isotropic) {
+        MultiFab err(grids[0], dmap[0], 1, 0);
+        MultiFab::Copy(err, solution[0], 0, 0, 1, 0);
+        MultiFab::Subtract(err, exact_solution[0], 0, 0, 1, 0);
+        const Real error = err.norminf(0);
+        amrex::Print() << "Solver options: max error " << error
+                       << " vs " << ref_error << " for the reference\n";
+        AMREX_ALWAYS_ASSERT(error < Real(0.01));
+        AMREX_ALWAYS_ASSERT(std::abs(error - ref_error) <= Real(1.e-6) * ref_error);
+    }
+}
+
 void
 MyTest::readParameters ()
 {
@@ -559,13 +1176,55 @@ MyTest::readParameters ()
     pp.query("max_semicoarsening_level", max_semicoarsening_level);
 
     pp.query("use_gauss_seidel", use_gauss_seidel);
+    pp.query("use_chebyshev", use_chebyshev);
+    pp.query("line_relaxation_dir", line_relaxation_dir);
 
     pp.query("use_gmres", use_gmres);
     AMREX_ALWAYS_ASSERT(use_gmres == false || prob_type == 2);
+    pp.query("gmres_compare_unbatched", gmres_compare_unbatched);
+
+    pp.query("check_telemetry", check_telemetry);
+
+    pp.query("compare_solver_options", compare_solver_options);
+    std::string bottom_solver_name = "default";
+    pp.query("bottom_solver", bottom_solver_name);
+    if (bottom_solver_name == "amg") {
+        bottom_solver = MLMG::BottomSolver::amg;
+    } else if (bottom_solver_name == "bicgstab") {
+        bottom_solver = MLMG::BottomSolver::bicgstab;
+    } else if (bottom_solver_name != "default") {
+        amrex::Abort("Unknown bottom_solver "+bottom_solver_name);
+    }
+    pp.query("amg_gather_max_cells", amg_gather_max_cells);
+    pp.query("plane_relaxation_dir", plane_relaxation_dir);
+    if (!pp.queryarr("bcoef_scale", bcoef_scale)) {
+        bcoef_scale.assign(AMREX_SPACEDIM, Real(1.0));
+    }
+    AMREX_ALWAYS_ASSERT(int(bcoef_scale.size()) >= AMREX_SPACEDIM);
+    bcoef_scale.resize(AMREX_SPACEDIM);
+    AMREX_ALWAYS_ASSERT(compare_solver_options == false || prob_type == 2);
+
+    pp.query("compare_temporal_blocking", compare_temporal_blocking);
+    if (!pp.queryarr("tb_box_sizes", tb_box_sizes)) {
+        tb_box_sizes = {8, 12, 32};
+    }
+    if (!pp.queryarr("tb_nsweeps", tb_nsweeps)) {
+        tb_nsweeps = {1, 2, 5};
+    }
+    AMREX_ALWAYS_ASSERT(compare_temporal_blocking == false || prob_type == 1 || prob_type == 2);
+    AMREX_ALWAYS_ASSERT(check_telemetry == false || (prob_type == 2 && composite_solve));
+
+    pp.query("componentwise_ncomp", componentwise_ncomp);
+    AMREX_ALWAYS_ASSERT(componentwise_ncomp <= 1 || prob_type == 2);
+
+    pp.query("solution_history_size", solution_history_size);
+    pp.query("num_solves", num_solves);
+    AMREX_ALWAYS_ASSERT(solution_history_size <= 0 || prob_type == 2);
 
 #ifdef AMREX_USE_HYPRE
     pp.query("use_hypre", use_hypre);
     pp.query("hypre_interface", hypre_interface_i);
+    pp.query("hypre_max_setup_reuse", hypre_max_setup_reuse);
     if (hypre_interface_i == 1) {
         hypre_interface = Hypre::Interface::structed;
     } else if (hypre_interface_i == 2) {
@@ -82,6 +82,8 @@ MyTest::solve ()
         mlmg.setBottomSolver(MLMG::BottomSolver::hypre);
     } else if (use_petsc) {
         mlmg.setBottomSolver(MLMG::BottomSolver::petsc);
+    } else if (use_amg) {
+        mlmg.setBottomSolver(MLMG::BottomSolver::amg);
     }
     const Real tol_rel = reltol;
     const Real tol_abs = 0.0;
@@ -143,6 +145,7 @@ MyTest::readParameters ()
 #ifdef AMREX_USE_PETSC
     pp.query("use_petsc",use_petsc);
 #endif
+    pp.query("use_amg", use_amg);
 }
 
 void
@@ -72,6 +72,10 @@ MyTest::solve ()
         mlmg.setBottomSolver(amrex::BottomSolver::hypre);
     }
 #endif
+    if (use_amg) {
+        mlmg.setBottomSolver(amrex::BottomSolver::amg);
+        mlmg.setAMGGatherMaxCells(amg_gather_max_cells);
+    }
 
     // In region with overset mask = 0, phi has valid solution and rhs is zero.
     Real mlmg_err = mlmg.solve({&phi}, {&rhs}, 1.e-11, 0.0);
@@ -110,6 +114,8 @@ MyTest::readParameters ()
     pp.query("max_coarsening_level", max_coarsening_level);
 
     pp.query("do_overset", do_overset);
+    pp.query("use_amg", use_amg);
+    pp.query("amg_gather_max_cells", amg_gather_max_cells);
 
 #ifdef AMREX_USE_HYPRE
     pp.query("use_hypre", use_hypre);
@@ -0,0 +1,151 @@
+#include "MyTest.H"
+
+#include <AMReX_MLFAS.H>
+#include <AMReX_ParmParse.H>
+
+using namespace amrex;
+
+void
+MLPoissonBoltzmann::applyNonlinear (int amrlev, int mglev, MultiFab& out, MultiFab& in,
+                                    BCMode bc_mode) const
+{
+    // out = lap(in)
+    auto const* bndry = (bc_mode == BCMode::Inhomogeneous)
+        ? m_bndry_sol[amrlev].get() : nullptr;
+    apply(amrlev, mglev, out, in, bc_mode, StateMode::Solution, bndry);
+
+    const Real kappa = m_kappa;
+    auto const& outma = out.arrays();
+    auto const& inma = in.const_arrays();
+    ParallelFor(out, [=] AMREX_GPU_DEVICE (int b, int i, int j, int k)
+    {
+        outma[b](i,j,k) = -outma[b](i,j,k) + kappa*std::sinh(inma[b](i,j,k));
+    });
+    Gpu::streamSynchronize();
+}
+
+void
+MLPoissonBoltzmann::smoothNonlinear (int amrlev, int mglev, MultiFab& sol,
+                                     const MultiFab& rhs, BCMode /*bc_mode*/) const
+{
+    // Red-black nonlinear Gauss-Seidel with one Newton step per cell. This
+    // assumes the domain is periodic.
+    const auto dxinv = Geom(amrlev,mglev).InvCellSizeArray();
+    const Real kappa = m_kappa;
+    for (int redblack = 0; redblack < 2; ++redblack)
+    {
+        sol.FillBoundary(Geom(amrlev,mglev).periodicity());
+        auto const& solma = sol.arrays();
+        auto const& rhsma = rhs.const_arrays();
+        ParallelFor(sol, [=] AMREX_GPU_DEVICE (int b, int i, int j, int k)
+        {
+            if ((i+j+k+redblack) % 2 == 0) {
+                auto const& u = solma[b];
+                Real lap = AMREX_D_TERM(
+                      dxinv[0]*dxinv[0]*(u(i-1,j,k) - Real(2.0)*u(i,j,k) + u(i+1,j,k)),
+                    + dxinv[1]*dxinv[1]*(u(i,j-1,k) - Real(2.0)*u(i,j,k) + u(i,j+1,k)),
+                    + dxinv[2]*dxinv[2]*(u(i,j,k-1) - Real(2.0)*u(i,j,k) + u(i,j,k+1)));
+                Real diag = Real(2.0) * (AMREX_D_TERM(dxinv[0]*dxinv[0],
+                                                     +dxinv[1]*dxinv[1],
+                                                     +dxinv[2]*dxinv[2]));
+                Real res = rhsma[b](i,j,k) + lap - kappa*std::sinh(u(i,j,k));
+                u(i,j,k) += res / (diag + kappa*std::cosh(u(i,j,k)));
+            }
+        });
+        Gpu::streamSynchronize();
+    }
+}
+
+MyTest::MyTest ()
+{
+    readParameters();
+    initData();
+}
+
+void
+MyTest::readParameters ()
+{
+    ParmParse pp;
+    pp.query("n_cell", n_cell);
+    pp.query("max_grid_size", max_grid_size);
+    pp.query("verbose", verbose);
+    pp.query("max_iter", max_iter);
+    pp.query("reltol", reltol);
+    pp.query("kappa", kappa);
+}
+
+void
+MyTest::initData ()
+{
+    RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+    Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(1,1,1)};
+    Box domain(IntVect(0), IntVect(n_cell-1));
+    geom.define(domain, rb, CoordSys::cartesian, is_periodic);
+
+    grids.define(domain);
+    grids.maxSize(max_grid_size);
+    dmap.define(grids);
+
+    solution.define(grids, dmap, 1, 1);
+    rhs.define(grids, dmap, 1, 0);
+    exact_solution.define(grids, dmap, 1, 0);
+
+    const auto problo = geom.ProbLoArray();
+    const auto dx = geom.CellSizeArray();
+    const Real kap = kappa;
+    constexpr Real tpi = Real(2.0)*Math::pi<Real>();
+    auto const& rhsma = rhs.arrays();
+    auto const& exactma = exact_solution.arrays();
+    ParallelFor(rhs, [=] AMREX_GPU_DEVICE (int b, int i, int j, int k)
+    {
+        AMREX_D_TERM(Real x = problo[0] + (i+Real(0.5))*dx[0];,
+                     Real y = problo[1] + (j+Real(0.5))*dx[1];,
+                     Real z = problo[2] + (k+Real(0.5))*dx[2];)
+        Real u = AMREX_D_TERM(std::sin(tpi*x), *std::sin(tpi*y), *std::sin(tpi*z));
+        exactma[b](i,j,k) = u;
+        rhsma[b](i,j,k) = AMREX_SPACEDIM*tpi*tpi*u + kap*std::sinh(u);
+        amrex::ignore_unused(j,k);
+    });
+    Gpu::streamSynchronize();
+
+    solution.setVal(0.0);
+}
+
+void
+MyTest::solve ()
+{
+    MLPoissonBoltzmann linop({geom}, {grids}, {dmap});
+
+    linop.setDomainBC({AMREX_D_DECL(LinOpBCType::Periodic,
+                                    LinOpBCType::Periodic,
+                                    LinOpBCType::Periodic)},
+                      {AMREX_D_DECL(LinOpBCType::Periodic,
+                                    LinOpBCType::Periodic,
+                                    LinOpBCType::Periodic)});
+    linop.setLevelBC(0, nullptr);
+    linop.setKappa(kappa);
+
+    MLFAS fas(linop);
+    fas.setVerbose(verbose);
+    fas.setMaxIter(max_iter);
+
+    fas.solve(solution, rhs, reltol, 0.0);
+}
+
+void
+MyTest::compute_norms () const
+{
+    MultiFab error(grids, dmap, 1, 0);
+    MultiFab::Copy(error, solution, 0, 0, 1, 0);
+    MultiFab::Subtract(error, exact_solution, 0, 0, 1, 0);
+    const Real max_error = error.norm0();
+    amrex::Print() << "max-norm of error: " << max_error << "\n";
+
+    // The discretization is second order.  The truncation error of the
+    // Laplacian of sin(2*pi*x) is (2*pi*dx)^2/12 relative to the Laplacian.
+    constexpr Real tpi = Real(2.0)*Math::pi<Real>();
+    const Real tpidx = tpi*geom.CellSize(0);
+    const Real bound = AMREX_SPACEDIM*tpidx*tpidx/Real(12.0);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(max_error < bound,
+                                     "FAS: max-norm of error exceeds the discretization error bound");
+}
@@ -18,6 +18,12 @@ void
 MyTest::solve ()
 {
     BL_PROFILE("NodalPoisson::solve()");
+
+    if (compare_single_precision_stencil) {
+        compareSinglePrecisionStencil();
+        return;
+    }
+
     LPInfo info;
     info.setAgglomeration(agglomeration);
     info.setConsolidation(consolidation);
@@ -124,6 +130,65 @@ MyTest::solve ()
     }
 }
 
+void
+MyTest::compareSinglePrecisionStencil ()
+{
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(max_level == 0,
+       "compareSinglePrecisionStencil: only single level is supported");
+
+    LPInfo info;
+    info.setAgglomeration(agglomeration);
+    info.setConsolidation(consolidation);
+    info.setMaxCoarseningLevel(max_coarsening_level);
+
+    Array<MultiFab,2> result;
+    Array<int,2> niters{};
+    for (int single = 0; single < 2; ++single)
+    {
+        MLNodeLaplacian linop({geom[0]}, {grids[0]}, {dmap[0]}, info);
+        linop.setCoarseningStrategy(MLNodeLaplacian::CoarseningStrategy::RAP);
+        linop.setSinglePrecisionStencil(single);
+
+        linop.setDomainBC({AMREX_D_DECL(LinOpBCType::Dirichlet,
+                                        LinOpBCType::Dirichlet,
+                                        LinOpBCType::Dirichlet)},
+                          {AMREX_D_DECL(LinOpBCType::Dirichlet,
+                                        LinOpBCType::Dirichlet,
+                                        LinOpBCType::Dirichlet)});
+
+        linop.setSigma(0, sigma[0]);
+
+        MLMG mlmg(linop);
+        mlmg.setMaxIter(max_iter);
+        mlmg.setMaxFmgIter(max_fmg_iter);
+        mlmg.setVerbose(verbose);
+        mlmg.setBottomVerbose(bottom_verbose);
+
+        auto& sol = result[single];
+        sol.define(solution[0].boxArray(), solution[0].DistributionMap(), 1, 0);
+        MultiFab::Copy(sol, exact_solution[0], 0, 0, 1, 0);
+        const Box& interior = amrex::surroundingNodes(amrex::grow(geom[0].Domain(), -1));
+        sol.setVal(0.0, interior, 0, 1, 0);
+
+        mlmg.solve({&sol}, {&rhs[0]}, reltol, 0.0);
+
+        AMREX_ALWAYS_ASSERT(mlmg.getFinalResidual() <= reltol*mlmg.getInitResidual());
+        niters[single] = mlmg.getNumIters();
+    }
+
+    // The single precision stencils only affect the coarse grid
+    // corrections, so the solutions may only differ at the level of the
+    // solver tolerance.
+    MultiFab::Copy(solution[0], result[0], 0, 0, 1, 0);
+    MultiFab::Subtract(result[1], result[0], 0, 0, 1, 0);
+    const Real diff = result[1].norm0();
+    const Real solnorm = result[0].norm0();
+    amrex::Print() << "Single precision stencil: " << niters[1] << " iterations vs. "
+                   << niters[0] << ", max difference " << diff << '\n';
+    AMREX_ALWAYS_ASSERT(niters[1] <= niters[0] + 1);
+    AMREX_ALWAYS_ASSERT(diff <= Real(100.)*reltol*solnorm);
+}
+
 void
 MyTest::compute_norms () const
 {
@@ -154,6 +219,7 @@ MyTest::readParameters ()
 
     pp.query("composite_solve", composite_solve);
     pp.query("use_gmres", use_gmres);
+    pp.query("compare_single_precision_stencil", compare_single_precision_stencil);
     if (use_gmres) {
         composite_solve = false;
     }
@@ -145,13 +145,14 @@ void test ()
     ParallelDescriptor::Barrier();
 
     char directory_path[512];
-    if (restart_check && nparticlefile > 0)
+    std::snprintf(directory_path, sizeof directory_path, "%s%s", directory.c_str(), "plt00000");
+
+    using PType = typename MyPC::SuperParticleType;
+
+    auto check_restart = [&] (const std::string& particle_name)
     {
         MyPC newPC(geom, dmap, ba, ref_ratio);
-        std::snprintf(directory_path, sizeof directory_path, "%s%s", directory.c_str(), "plt00000");
-        newPC.Restart(directory_path, "particle0");
-
-        using PType = typename MyPC::SuperParticleType;
+        newPC.Restart(directory_path, particle_name);
 
         for (int icomp=0; icomp<NStructReal+NArrayReal+NStructInt+NArrayInt; ++icomp)
         {
@@ -172,6 +173,92 @@ void test ()
 
             AMREX_ALWAYS_ASSERT(sm_old == sm_new);
         }
+
+        // Only read the particles in the lower half of the domain, and only one real component
+        RealBox half = real_box;
+        half.setHi(0, 0.5);
+
+        ParticleReadSubset subset;
+        subset.setRegion(half);
+        subset.real_comps = {"particle_real_component_1"};
+
+        MyPC subPC(geom, dmap, ba, ref_ratio);
+        subPC.Restart(directory_path, particle_name, subset);
+
+        auto np_half = amrex::ReduceSum(myPC,
+            [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Long
+            {
+                return p.pos(0) < 0.5 ? 1 : 0;
+            });
+        auto sm_half = amrex::ReduceSum(myPC,
+            [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
+            {
+                return p.pos(0) < 0.5 ? p.rdata(1) : 0.0;
+            });
+        auto sm_sub = amrex::ReduceSum(subPC,
+            [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
+            {
+                return p.rdata(1);
+            });
+        auto sm_unread = amrex::ReduceSum(subPC,
+            [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
+            {
+                return amrex::Math::abs(p.rdata(2));
+            });
+
+        ParallelDescriptor::ReduceLongSum(np_half);
+        ParallelDescriptor::ReduceRealSum(sm_half);
+        ParallelDescriptor::ReduceRealSum(sm_sub);
+        ParallelDescriptor::ReduceRealSum(sm_unread);
+
+        AMREX_ALWAYS_ASSERT(subPC.TotalNumberOfParticles() == np_half);
+        AMREX_ALWAYS_ASSERT(sm_sub == sm_half);
+        AMREX_ALWAYS_ASSERT(sm_unread == 0.0);
+
+        const Long np_total = myPC.TotalNumberOfParticles();
+        if (particle_detail::useColumnarIO() && ParallelDescriptor::IOProcessor())
+        {
+            ColumnarParticleReader reader(directory_path, particle_name);
+            AMREX_ALWAYS_ASSERT(reader.numParticles() == np_total);
+
+            ParticleReadSubset column_subset;
+            column_subset.setRegion(half);
+            column_subset.real_comps = {"particle_real_component_4"};
+            column_subset.int_comps = {"particle_int_component_1"};
+
+            auto data = reader.read(column_subset);
+            AMREX_ALWAYS_ASSERT(data.size() == np_half);
+            AMREX_ALWAYS_ASSERT(data.real_data.size() == 1 && data.int_data.size() == 1);
+            for (Long i = 0; i < data.size(); ++i) {
+                AMREX_ALWAYS_ASSERT(data.pos[0][i] < 0.5 && data.id[i] > 0);
+                AMREX_ALWAYS_ASSERT(data.real_data[0][i] == pdata.real_array_data[0]);
+                AMREX_ALWAYS_ASSERT(data.int_data[0][i] == pdata.int_array_data[0]);
+            }
+        }
+    };
+
+    if (restart_check && nparticlefile > 0)
+    {
+        check_restart("particle0");
+
+        // Write the same particles in the columnar format and check again
+        ParmParse ppp("particles");
+        ppp.add("columnar_io", 1);
+
+        Vector<std::string> particle_realnames;
+        for (int i = 0; i < NStructReal + NArrayReal; ++i) {
+            particle_realnames.push_back("particle_real_component_" + std::to_string(i));
+        }
+
+        Vector<std::string> particle_intnames;
+        for (int i = 0; i < NStructInt + NArrayInt; ++i) {
+            particle_intnames.push_back("particle_int_component_" + std::to_string(i));
+        }
+
+        myPC.Checkpoint(directory_path, "particle_columnar", true, particle_realnames, particle_intnames);
+        ParallelDescriptor::Barrier();
+
+        check_restart("particle_columnar");
     }
 }
 
@@ -1,9 +1,12 @@
 #include <AMReX.H>
 #include <AMReX_DenseBins.H>
+#include <AMReX_SparseBins.H>
 #include <AMReX_GpuContainers.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_Vector.H>
 
+#include <algorithm>
+
 using namespace amrex;
 
 void checkAnswer (const amrex::DenseBins<int>& bins)
@@ -69,22 +72,68 @@ void testGPU (int nbins, const amrex::Vector<int>& items)
     checkAnswer(bins);
 }
 
-void testOpenMP (int nbins, const amrex::Vector<int>& items)
+void checkSame (const amrex::DenseBins<int>& a, const amrex::DenseBins<int>& b)
+{
+    BL_PROFILE("checkSame");
+    AMREX_ALWAYS_ASSERT(a.numItems() == b.numItems() && a.numBins() == b.numBins());
+    AMREX_ALWAYS_ASSERT(std::equal(a.permutationPtr(), a.permutationPtr()+a.numItems(),
+                                   b.permutationPtr()));
+    AMREX_ALWAYS_ASSERT(std::equal(a.offsetsPtr(), a.offsetsPtr()+a.numBins()+1,
+                                   b.offsetsPtr()));
+}
+
+void testOpenMP (int nbins, const amrex::Vector<int>& items, const amrex::DenseBins<int>& serial_bins)
 {
     amrex::DenseBins<int> bins;
+    auto t0 = amrex::second();
     bins.build(BinPolicy::OpenMP, items.size(), items.data(), nbins, [=] (int j) noexcept -> unsigned int { return j ; });
+    amrex::Print() << "OpenMP build with " << OpenMP::get_max_threads() << " threads: "
+                   << amrex::second()-t0 << " s\n";
 
     checkAnswer(bins);
+    checkSame(bins, serial_bins);
 }
 
-void testSerial (int nbins, const amrex::Vector<int>& items)
+void testSerial (int nbins, const amrex::Vector<int>& items, amrex::DenseBins<int>& bins)
 {
-    amrex::DenseBins<int> bins;
+    auto t0 = amrex::second();
     bins.build(BinPolicy::Serial, items.size(), items.data(), nbins, [=] (int j) noexcept -> unsigned int { return j ; });
+    amrex::Print() << "Serial build: " << amrex::second()-t0 << " s\n";
 
     checkAnswer(bins);
 }
 
+void testSparse (int nbins, const amrex::Vector<int>& items)
+{
+    // every other bin is empty
+    const Box bx(IntVect(0), IntVect(AMREX_D_DECL(2*nbins-1, 0, 0)));
+    amrex::SparseBins<int> bins;
+    auto t0 = amrex::second();
+    bins.build(items.size(), items.data(), bx,
+               [=] (int j) noexcept -> IntVect { return IntVect(AMREX_D_DECL(2*j, 0, 0)); });
+    amrex::Print() << "SparseBins build with " << OpenMP::get_max_threads() << " threads: "
+                   << amrex::second()-t0 << " s\n";
+
+    Gpu::HostVector<int> perm(bins.numItems());
+    Gpu::HostVector<int> offsets(bins.numBins()+1);
+    Gpu::HostVector<int> nonzero_bins(bins.numBins());
+    Gpu::copyAsync(Gpu::deviceToHost, bins.permutationPtr(), bins.permutationPtr()+perm.size(), perm.begin());
+    Gpu::copyAsync(Gpu::deviceToHost, bins.offsetsPtr(), bins.offsetsPtr()+offsets.size(), offsets.begin());
+    Gpu::copyAsync(Gpu::deviceToHost, bins.getNonZeroBinsPtr(), bins.getNonZeroBinsPtr()+nonzero_bins.size(),
+                   nonzero_bins.begin());
+    Gpu::streamSynchronize();
+
+    AMREX_ALWAYS_ASSERT(offsets[0] == 0 && offsets[bins.numBins()] == bins.numItems());
+    for (int b = 0; b < bins.numBins(); ++b) {
+        AMREX_ALWAYS_ASSERT(offsets[b] < offsets[b+1]);
+        AMREX_ALWAYS_ASSERT(b == 0 || nonzero_bins[b-1] < nonzero_bins[b]);
+        for (int k = offsets[b]; k < offsets[b+1]; ++k) {
+            AMREX_ALWAYS_ASSERT(2*items[perm[k]] == nonzero_bins[b]);
+            AMREX_ALWAYS_ASSERT(k == offsets[b] || perm[k-1] < perm[k]);
+        }
+    }
+}
+
 void initData (int nbins, amrex::Vector<int>& items)
 {
     BL_PROFILE("init");
@@ -110,10 +159,12 @@ void testDenseBins ()
     initData(nbins, items);
 
 #ifndef AMREX_USE_SYCL
-    testSerial(nbins, items);
-#endif
+    amrex::DenseBins<int> serial_bins;
+    testSerial(nbins, items, serial_bins);
 #ifdef AMREX_USE_OMP
-    testOpenMP(nbins, items);
+    testOpenMP(nbins, items, serial_bins);
+#endif
+    testSparse(nbins, items);
 #endif
 #ifdef AMREX_USE_GPU
     testGPU(nbins, items);
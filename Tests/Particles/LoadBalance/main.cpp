@@ -0,0 +1,151 @@
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_Particles.H>
+
+using namespace amrex;
+
+using PC = ParticleContainer<1, 0, 0, 0>;
+
+struct TestParams
+{
+    int n_cell = 32;
+    int max_grid_size = 8;
+    int num_ppc = 4;
+};
+
+void get_test_params (TestParams& params)
+{
+    ParmParse pp;
+    pp.query("n_cell", params.n_cell);
+    pp.query("max_grid_size", params.max_grid_size);
+    pp.query("num_ppc", params.num_ppc);
+}
+
+// Put num_ppc particles in every cell of the low corner octant of the domain
+// and none elsewhere, so that the grids holding the clump cost far more than
+// the others.
+void initClumpedParticles (PC& pc, const Box& clump, int num_ppc)
+{
+    const int lev = 0;
+    const auto plo = pc.Geom(lev).ProbLoArray();
+    const auto dx = pc.Geom(lev).CellSizeArray();
+
+    for (MFIter mfi = pc.MakeMFIter(lev); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox() & clump;
+        if (!bx.ok()) { continue; }
+
+        Gpu::HostVector<PC::ParticleType> host_particles;
+        for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv))
+        {
+            for (int n = 0; n < num_ppc; ++n)
+            {
+                const Real r = (Real(n) + Real(0.5)) / Real(num_ppc);
+                PC::ParticleType p;
+                p.id() = PC::ParticleType::NextID();
+                p.cpu() = ParallelDescriptor::MyProc();
+                AMREX_D_TERM(p.pos(0) = static_cast<ParticleReal>(plo[0] + (iv[0] + r)*dx[0]);,
+                             p.pos(1) = static_cast<ParticleReal>(plo[1] + (iv[1] + r)*dx[1]);,
+                             p.pos(2) = static_cast<ParticleReal>(plo[2] + (iv[2] + r)*dx[2]);)
+                p.rdata(0) = Real(1.0);
+                host_particles.push_back(p);
+            }
+        }
+
+        auto& ptile = pc.DefineAndReturnParticleTile(lev, mfi.index(), mfi.LocalTileIndex());
+        auto old_size = ptile.GetArrayOfStructs().size();
+        ptile.resize(old_size + host_particles.size());
+        Gpu::copyAsync(Gpu::hostToDevice, host_particles.begin(), host_particles.end(),
+                       ptile.GetArrayOfStructs().begin() + old_size);
+    }
+    Gpu::streamSynchronize();
+}
+
+// The largest total cost of the grids of a process
+Real maxCostPerRank (const PC& pc, const MeshParticleCostModel& model)
+{
+    LayoutData<Real> cost = pc.MeshParticleCost(0, model);
+    Real local_cost = Real(0.0);
+    for (MFIter mfi(cost); mfi.isValid(); ++mfi) {
+        local_cost += cost[mfi];
+    }
+    ParallelDescriptor::ReduceRealMax(local_cost);
+    return local_cost;
+}
+
+void testLoadBalance (const TestParams& params, DistributionMapping::Strategy strategy)
+{
+    const Box domain(IntVect(0), IntVect(params.n_cell-1));
+    RealBox real_box;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        real_box.setLo(idim, Real(0.0));
+        real_box.setHi(idim, Real(1.0));
+    }
+    const Array<int,AMREX_SPACEDIM> is_per{AMREX_D_DECL(1,1,1)};
+    const Geometry geom(domain, real_box, CoordSys::cartesian, is_per);
+
+    BoxArray ba(domain);
+    ba.maxSize(params.max_grid_size);
+    DistributionMapping dm(ba);
+
+    // stands in for the mesh data of an application
+    MultiFab mesh(ba, dm, 1, 0);
+    mesh.setVal(Real(1.0));
+
+    PC pc(geom, dm, ba);
+    const Box clump(IntVect(0), IntVect(params.n_cell/2-1));
+    initClumpedParticles(pc, clump, params.num_ppc);
+    pc.Redistribute();
+
+    const Long np = pc.TotalNumberOfParticles();
+    AMREX_ALWAYS_ASSERT(np == Long(params.num_ppc) * clump.numPts());
+
+    const MeshParticleCostModel model(Real(1.0), Real(1.0));
+    const Real max_cost_before = maxCostPerRank(pc, model);
+
+    auto remake_mesh = [&] (int lev, const DistributionMapping& new_dm)
+    {
+        AMREX_ALWAYS_ASSERT(lev == 0);
+        MultiFab new_mesh(ba, new_dm, 1, 0);
+        new_mesh.ParallelCopy(mesh);
+        std::swap(mesh, new_mesh);
+    };
+
+    const bool changed = pc.LoadBalance(model, remake_mesh, strategy);
+
+    // With one process there is nothing to balance.
+    AMREX_ALWAYS_ASSERT(changed == (ParallelDescriptor::NProcs() > 1));
+    AMREX_ALWAYS_ASSERT(pc.ParticleDistributionMap(0) == mesh.DistributionMap());
+    AMREX_ALWAYS_ASSERT(pc.TotalNumberOfParticles() == np);
+    AMREX_ALWAYS_ASSERT(pc.OK());
+    AMREX_ALWAYS_ASSERT(mesh.min(0) == Real(1.0) && mesh.max(0) == Real(1.0));
+
+    const Real max_cost_after = maxCostPerRank(pc, model);
+    amrex::Print() << "  max cost per rank: " << max_cost_before
+                   << " -> " << max_cost_after << "\n";
+    if (changed) {
+        AMREX_ALWAYS_ASSERT(max_cost_after < max_cost_before);
+    }
+
+    // The new distribution is already balanced, so nothing changes again.
+    AMREX_ALWAYS_ASSERT(!pc.LoadBalance(model, remake_mesh, strategy));
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        TestParams params;
+        get_test_params(params);
+
+        amrex::Print() << "Testing LoadBalance with KNAPSACK\n";
+        testLoadBalance(params, DistributionMapping::KNAPSACK);
+
+        amrex::Print() << "Testing LoadBalance with SFC\n";
+        testLoadBalance(params, DistributionMapping::SFC);
+
+        amrex::Print() << "pass \n";
+    }
+    amrex::Finalize();
+}
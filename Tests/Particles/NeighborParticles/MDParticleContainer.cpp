@@ -372,6 +372,75 @@ void MDParticleContainer::checkNeighborList()
     amrex::PrintToFile("neighbor_test") << "All the neighbor list particles match!" << '\n';
 }
 
+void MDParticleContainer::checkHalfNeighborList()
+{
+    BL_PROFILE("MDParticleContainer::checkHalfNeighborList");
+
+    const int lev = 0;
+    auto& plev  = GetParticles(lev);
+
+    // count the pairs of each particle with a symmetric update, using ax as the counter
+    for (MFIter mfi = MakeMFIter(lev); mfi.isValid(); ++mfi)
+    {
+        auto index = std::make_pair(mfi.index(), mfi.LocalTileIndex());
+        auto& aos = plev[index].GetArrayOfStructs();
+        ParticleType* pstruct = aos().dataPtr();
+
+        AMREX_FOR_1D ( aos.numTotalParticles(), i,
+        {
+            pstruct[i].rdata(PIdx::ax) = 0.0;
+        });
+
+        m_neighbor_list[lev][index].forEachPair(
+            [=] AMREX_GPU_DEVICE (int i, int j)
+            {
+                pstruct[i].rdata(PIdx::ax) += 1.0;
+                pstruct[j].rdata(PIdx::ax) += 1.0;
+            });
+    }
+
+    sumNeighbors(PIdx::ax, 1, 0, 0);
+
+    Long num_full = 0;
+    Long num_half = 0;
+    for (MFIter mfi = MakeMFIter(lev); mfi.isValid(); ++mfi)
+    {
+        auto index = std::make_pair(mfi.index(), mfi.LocalTileIndex());
+        auto& aos = plev[index].GetArrayOfStructs();
+
+        const int np       = aos.numParticles();
+        const int np_total = aos.numTotalParticles();
+
+        amrex::Gpu::HostVector<ParticleType> h_pstruct(np_total);
+        Gpu::copy(Gpu::deviceToHost, aos().dataPtr(), aos().dataPtr() + np_total, h_pstruct.begin());
+
+        // each particle should have been counted once for every neighbor
+        for (int i = 0; i < np; i++)
+        {
+            int full_count = 0;
+            for (int j = 0; j < np_total; j++)
+            {
+                if ( i == j ) { continue; }
+                AMREX_D_TERM(Real dx = h_pstruct[i].pos(0) - h_pstruct[j].pos(0);,
+                             Real dy = h_pstruct[i].pos(1) - h_pstruct[j].pos(1);,
+                             Real dz = h_pstruct[i].pos(2) - h_pstruct[j].pos(2);)
+                Real r2 = AMREX_D_TERM(dx*dx, + dy*dy, + dz*dz);
+                if (r2 <= 25.0*Params::cutoff*Params::cutoff) { ++full_count; }
+            }
+            AMREX_ALWAYS_ASSERT(h_pstruct[i].rdata(PIdx::ax) == Real(full_count));
+            num_full += full_count;
+        }
+        num_half += m_neighbor_list[lev][index].GetList().size();
+    }
+
+    // the half lists store half of the pairs
+    ParallelDescriptor::ReduceLongSum(num_full);
+    ParallelDescriptor::ReduceLongSum(num_half);
+    AMREX_ALWAYS_ASSERT(num_full > 0 && num_full == 2*num_half);
+
+    amrex::PrintToFile("neighbor_test") << "All the half neighbor list pairs match!" << '\n';
+}
+
 void MDParticleContainer::reset_test_id()
 {
     BL_PROFILE("MDParticleContainer::reset_test_id");
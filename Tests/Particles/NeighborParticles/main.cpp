@@ -156,6 +156,20 @@ void testNeighborParticles ()
     pc.updateNeighbors();
 
     amrex::PrintToFile("neighbor_test") << "Min distance is " << pc.minAndMaxDistance() << ", should be (1, 1) \n";
+
+    amrex::PrintToFile("neighbor_test") << "Testing Verlet neighbor lists \n";
+    pc.setVerletSkin(0.5);
+    pc.buildNeighborList(CheckPair());
+    for (int step = 1; step <= 4; ++step) {
+        // each step moves the particles by sqrt(3)*0.1, so the list is rebuilt
+        // every other step, when the displacement exceeds half the skin.
+        pc.moveParticles(static_cast<amrex::ParticleReal> (0.1));
+        bool rebuilt = pc.updateNeighborList(CheckPair());
+        AMREX_ALWAYS_ASSERT(rebuilt == (step % 2 == 0));
+        amrex::PrintToFile("neighbor_test") << "Step " << step << " rebuilt " << rebuilt
+                                            << ", min distance is " << pc.minAndMaxDistance()
+                                            << ", should be (1, 1) \n";
+    }
 }
 
 void testNeighborList ()
@@ -201,6 +215,43 @@ void testNeighborList ()
         pc.checkNeighborList();
     }
 
+#ifndef AMREX_USE_GPU
+    // half lists with symmetric updates, summed back to the owners
+    if (params.check_answer) {
+        pc.setEnableInverse(true);
+        pc.clearNeighbors();
+        pc.fillNeighbors();
+        pc.setHalfNeighborList(true);
+        pc.buildNeighborList(CheckPair());
+        pc.checkHalfNeighborList();
+
+        // A particle that has moved out of its tile since the last
+        // Redistribute can be at the same position as a particle of another
+        // tile.  Both tiles must keep the pair exactly once.
+        using PType = MDParticleContainer::ParticleType;
+        PType pq[2];
+        for (auto& p : pq) {
+            AMREX_D_TERM(p.pos(0) = 1.5;, p.pos(1) = 2.5;, p.pos(2) = 3.5;)
+            p.cpu() = 0;
+        }
+        pq[0].id() = 1;
+        pq[1].id() = 2;
+        for (int same_id = 0; same_id < 2; ++same_id) {
+            if (same_id) {
+                pq[1].id() = 1;
+                pq[1].cpu() = 1;
+            }
+            const PType qp[2] = {pq[1], pq[0]};
+            const bool keep_on_p = detail::halfListHasSameCellPair(pq, 0, 1, true);
+            const bool keep_on_q = detail::halfListHasSameCellPair(qp, 0, 1, true);
+            AMREX_ALWAYS_ASSERT(keep_on_p != keep_on_q);
+        }
+
+        pc.setHalfNeighborList(false);
+        pc.buildNeighborList(CheckPair());
+    }
+#endif
+
 #ifdef AMREX_USE_GPU
     pc.clearNeighbors();
     pc.fillNeighbors();
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <limits>
 
 #include <AMReX.H>
 #include <AMReX_MultiFab.H>
@@ -19,6 +20,66 @@ struct TestParams {
   bool verbose;
 };
 
+// Deposit the mass, rdata(0), of the particles onto rho with Shape<Order>
+template <int Order, typename PC>
+void depositMass (PC const& pc, MultiFab& rho)
+{
+    const auto plo = pc.Geom(0).ProbLoArray();
+    const auto dxi = pc.Geom(0).InvCellSizeArray();
+
+    amrex::ParticleToMesh(pc, rho, 0,
+        [=] AMREX_GPU_DEVICE (const typename PC::ParticleTileType::ConstParticleTileDataType& ptd, int i,
+                              amrex::Array4<amrex::Real> const& arr)
+        {
+            ParticleInterpolator::Shape<Order> interp(ptd, i, plo, dxi);
+            interp.ParticleToMesh(i, arr, 0, 0, 1,
+                [=] AMREX_GPU_DEVICE (int ip, int /*comp*/) -> Real
+                {
+                    return ptd.m_aos[ip].rdata(0);
+                });
+        });
+}
+
+// Interpolate a linear field to the particles with Shape<Order> and
+// return the max error.  The B-splines of order >= 1 reproduce linear
+// functions, so the error should be at the level of round-off.
+template <int Order, typename PC>
+Real linearGatherError (PC& pc, MultiFab const& lin,
+                        GpuArray<Real,AMREX_SPACEDIM> const& slope, int dst_comp)
+{
+    const auto plo = pc.Geom(0).ProbLoArray();
+    const auto dxi = pc.Geom(0).InvCellSizeArray();
+
+    amrex::MeshToParticle(pc, lin, 0,
+        [=] AMREX_GPU_DEVICE (const typename PC::ParticleTileType::ParticleTileDataType& ptd, int ip,
+                              amrex::Array4<const amrex::Real> const& arr)
+        {
+            auto& p = ptd.m_aos[ip];
+            p.rdata(dst_comp) = 0;
+            ParticleInterpolator::Shape<Order> interp(ptd, ip, plo, dxi);
+            interp.MeshToParticle(p, arr, 0, dst_comp, 1,
+                [=] AMREX_GPU_DEVICE (amrex::Array4<const amrex::Real> const& a,
+                                      int i, int j, int k, int comp)
+                {
+                    return a(i, j, k, comp);
+                },
+                [=] AMREX_GPU_DEVICE (typename PC::ParticleType& part, int comp, amrex::Real val)
+                {
+                    part.rdata(comp) += ParticleReal(val);
+                });
+        });
+
+    return amrex::ReduceMax(pc,
+        [=] AMREX_GPU_HOST_DEVICE (const typename PC::ParticleType& p) -> Real
+        {
+            Real exact = 1.0;
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                exact += slope[idim] * p.pos(idim);
+            }
+            return std::abs(Real(p.rdata(dst_comp)) - exact);
+        });
+}
+
 void testParticleMesh (TestParams& parms)
 {
 
@@ -89,6 +150,24 @@ void testParticleMesh (TestParams& parms)
                       });
       });
 
+  // The B-spline interpolators agree with Linear, and the higher order
+  // shapes conserve the mass.
+  {
+      MultiFab rho(ba, dmap, 1, 2);
+      depositMass<1>(myPC, rho);
+      MultiFab::Subtract(rho, partMF, 0, 0, 1, 0);
+      Real err = rho.norminf(0) / partMF.norminf(0);
+      AMREX_ALWAYS_ASSERT(err < 1.e-12);
+
+      const Real total_mass = mass * num_particles;
+      depositMass<2>(myPC, rho);
+      AMREX_ALWAYS_ASSERT(std::abs(rho.sum(0) - total_mass) < 1.e-10*total_mass);
+      depositMass<3>(myPC, rho);
+      AMREX_ALWAYS_ASSERT(std::abs(rho.sum(0) - total_mass) < 1.e-10*total_mass);
+      depositMass<4>(myPC, rho);
+      AMREX_ALWAYS_ASSERT(std::abs(rho.sum(0) - total_mass) < 1.e-10*total_mass);
+  }
+
   MultiFab acceleration(ba, dmap, AMREX_SPACEDIM, 1);
   acceleration.setVal(5.0);
 
@@ -112,6 +191,37 @@ void testParticleMesh (TestParams& parms)
                   });
       });
 
+  // Gather a linear field with the B-spline shapes.  The ghost cells are
+  // filled with the linear function instead of the periodic images so
+  // that the field is linear in the whole stencil.
+  {
+      GpuArray<Real,AMREX_SPACEDIM> slope{AMREX_D_DECL(1.0, 2.0, 3.0)};
+      MultiFab lin(ba, dmap, 1, 3);
+      for (MFIter mfi(lin); mfi.isValid(); ++mfi) {
+          auto const& arr = lin.array(mfi);
+          amrex::ParallelFor(mfi.fabbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k)
+          {
+              IntVect iv(AMREX_D_DECL(i,j,k));
+              Real v = 1.0;
+              for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                  v += slope[idim] * (plo[idim] + (iv[idim]+Real(0.5))/dxi[idim]);
+              }
+              arr(i,j,k) = v;
+          });
+      }
+
+      const int dst_comp = 1 + AMREX_SPACEDIM;
+      const Real tol = Real(100.) * std::numeric_limits<ParticleReal>::epsilon()
+          * (Real(1.0) + AMREX_D_TERM(slope[0], + slope[1], + slope[2]));
+      const Real err1 = linearGatherError<1>(myPC, lin, slope, dst_comp);
+      const Real err2 = linearGatherError<2>(myPC, lin, slope, dst_comp);
+      const Real err3 = linearGatherError<3>(myPC, lin, slope, dst_comp);
+      const Real err4 = linearGatherError<4>(myPC, lin, slope, dst_comp);
+      amrex::Print() << "Linear field gather errors: " << err1 << " " << err2 << " "
+                     << err3 << " " << err4 << '\n';
+      AMREX_ALWAYS_ASSERT(err1 < tol && err2 < tol && err3 < tol && err4 < tol);
+  }
+
   // now also try the iMultiFab versions
   amrex::ParticleToMesh(myPC, partiMF, 0,
       [=] AMREX_GPU_DEVICE (const MyParticleContainer::SuperParticleType& p,
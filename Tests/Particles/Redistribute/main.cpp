@@ -263,6 +263,47 @@ public:
         }
     }
 
+    // If max_disorder is negative, check that the particles on each tile
+    // are in Morton order.  Otherwise, check that the fraction of the
+    // consecutive pairs out of order at the granularity of the 4^dim blocks
+    // of cells is at most max_disorder, as guaranteed by the automatic
+    // sorting.
+    void checkMortonOrder (Real max_disorder) const
+    {
+        BL_PROFILE("TestParticleContainer::checkMortonOrder");
+
+        for (int lev = 0; lev <= finestLevel(); ++lev)
+        {
+            const auto plo = Geom(lev).ProbLoArray();
+            const auto dxi = Geom(lev).InvCellSizeArray();
+            const Box domain = Geom(lev).Domain();
+            const auto& plev  = GetParticles(lev);
+            for(MFIter mfi = MakeMFIter(lev); mfi.isValid(); ++mfi)
+            {
+                const auto& ptile = plev.at(std::make_pair(mfi.index(), mfi.LocalTileIndex()));
+                const auto np = static_cast<Long>(ptile.numParticles());
+                if (np < 2) { continue; }
+
+                const Box box = mfi.validbox();
+                const IntVect nbits = mortonKeyBits(box);
+                const GetParticleMortonKey get_key{plo, dxi, domain, box, nbits};
+                int shift = 0;
+                if (max_disorder >= Real(0.0)) {
+                    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                        shift += amrex::min(nbits[idim], 2);
+                    }
+                }
+                const auto ptd = ptile.getConstParticleTileData();
+                const Long ndisorder = Reduce::Sum<Long>(np-1,
+                    [=] AMREX_GPU_DEVICE (Long i) -> Long
+                    {
+                        return ((get_key(ptd[i+1]) >> shift) < (get_key(ptd[i]) >> shift)) ? 1 : 0;
+                    });
+                AMREX_ALWAYS_ASSERT(Real(ndisorder) <= amrex::max(max_disorder, Real(0.0)) * Real(np));
+            }
+        }
+    }
+
     void checkAnswer () const
     {
         BL_PROFILE("TestParticleContainer::checkAnswer");
@@ -327,11 +368,22 @@ struct TestParams
     int nlevs;
     int do_regrid;
     int sort;
+    int morton_sort = 0;
     int test_level_lost = 0;
+    int incremental = 0;
+    Real auto_sort_threshold = -1.0;
+    int tile_capacity_hysteresis = 0;
+    int tile_pool_size = 0;
 };
 
 void testRedistribute();
 
+ParticleTileAllocCounts runRedistribute (TestParams const& params,
+                                         Vector<Geometry> const& geom,
+                                         Vector<DistributionMapping> const& dm,
+                                         Vector<BoxArray> const& ba,
+                                         Vector<IntVect> const& rr);
+
 int main (int argc, char* argv[])
 {
     amrex::Initialize(argc,argv);
@@ -361,6 +413,11 @@ void get_test_params(TestParams& params, const std::string& prefix)
 
     params.sort = 0;
     pp.query("sort", params.sort);
+    pp.query("morton_sort", params.morton_sort);
+    pp.query("incremental", params.incremental);
+    pp.query("auto_sort_threshold", params.auto_sort_threshold);
+    pp.query("tile_capacity_hysteresis", params.tile_capacity_hysteresis);
+    pp.query("tile_pool_size", params.tile_pool_size);
 }
 
 void testRedistribute ()
@@ -409,7 +466,49 @@ void testRedistribute ()
         size *= 2;
     }
 
+    const auto counts = runRedistribute(params, geom, dm, ba, rr);
+
+    if (params.tile_pool_size > 0 || params.tile_capacity_hysteresis > 0) {
+        // Same sequence of moves and regrids with the default tile storage.
+        // The random seed is reset to the one set by amrex::Initialize.
+        TestParams params_default = params;
+        params_default.tile_capacity_hysteresis = 0;
+        params_default.tile_pool_size = 0;
+        amrex::ResetRandomSeed(ParallelDescriptor::MyProc()+1);
+        const auto counts_default = runRedistribute(params_default, geom, dm, ba, rr);
+
+        Long nrealloc[2] = {counts.reallocations, counts_default.reallocations};
+        ParallelDescriptor::ReduceLongSum(nrealloc, 2);
+        amrex::Print() << "Tile reallocations: " << nrealloc[0] << " with hysteresis and pool, "
+                       << nrealloc[1] << " without\n";
+        AMREX_ALWAYS_ASSERT(nrealloc[0] < nrealloc[1]);
+    }
+
+    if (params.tile_pool_size > 0) {
+        // The pool is big enough for all the tiles that get emptied, so no
+        // tile storage is freed.  With more than one process, the regrids move
+        // grids between processes and the new tiles come from the pool.
+        AMREX_ALWAYS_ASSERT(counts.frees == 0);
+        if (ParallelDescriptor::NProcs() > 1) {
+            AMREX_ALWAYS_ASSERT(counts.pool_reuses > 0);
+        }
+    }
+
+    // the way this test is set up, if we make it here we pass
+    amrex::Print() << "pass \n";
+}
+
+ParticleTileAllocCounts runRedistribute (TestParams const& params,
+                                         Vector<Geometry> const& geom,
+                                         Vector<DistributionMapping> const& dm,
+                                         Vector<BoxArray> const& ba,
+                                         Vector<IntVect> const& rr)
+{
     TestParticleContainer pc(geom, dm, ba, rr);
+    pc.SetIncrementalRedistribute(params.incremental);
+    pc.SetAutoSortThreshold(params.auto_sort_threshold);
+    pc.SetTileCapacityHysteresis(params.tile_capacity_hysteresis);
+    pc.SetTilePoolSize(params.tile_pool_size);
 
     IntVect nppc(params.num_ppc);
 
@@ -435,6 +534,12 @@ void testRedistribute ()
         }
         pc.RedistributeLocal();
         if (params.sort) { pc.SortParticlesByCell(); }
+        if (params.morton_sort) {
+            pc.SortParticlesByMorton();
+            pc.checkMortonOrder(Real(-1.0));
+        } else if (params.auto_sort_threshold >= Real(0.0)) {
+            pc.checkMortonOrder(params.auto_sort_threshold);
+        }
         pc.checkAnswer();
     }
 
@@ -500,6 +605,12 @@ void testRedistribute ()
         AMREX_ALWAYS_ASSERT(np_old == pc.TotalNumberOfParticles());
     }
 
-    // the way this test is set up, if we make it here we pass
-    amrex::Print() << "pass \n";
+    auto counts = pc.TileAllocCounts();
+    amrex::AllPrint() << "Rank " << ParallelDescriptor::MyProc()
+                      << ": tile reallocations " << counts.reallocations
+                      << ", frees " << counts.frees
+                      << ", pool reuses " << counts.pool_reuses
+                      << ", shrinks " << counts.shrinks << "\n";
+
+    return counts;
 }
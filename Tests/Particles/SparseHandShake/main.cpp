@@ -0,0 +1,76 @@
+#include <AMReX.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_ParticleMPIUtil.H>
+#include <AMReX_Random.H>
+
+#include <map>
+
+using namespace amrex;
+
+// Check that ParallelDescriptor::SparseHandShake finds the same receive
+// counts as the all-to-all handshake of the particle Redistribute for
+// random sparse send patterns.
+void testSparseHandShake ()
+{
+#ifdef AMREX_USE_MPI
+    int ntrials = 20;
+    int max_dests = 3;
+    {
+        ParmParse pp;
+        pp.query("ntrials", ntrials);
+        pp.query("max_dests", max_dests);
+    }
+
+    // The number of processes is far below the default of
+    // particles.nbx_handshake_min_procs, so doHandShake uses MPI_Alltoall.
+    const int nprocs = ParallelContext::NProcsSub();
+    const int myproc = ParallelContext::MyProcSub();
+    AMREX_ALWAYS_ASSERT(nprocs < NBXHandShakeMinProcs());
+
+    for (int trial = 0; trial < ntrials; ++trial)
+    {
+        // Some processes send nothing, and some send to several others.
+        std::map<int, Vector<char> > not_ours;
+        const int ndests = (nprocs > 1) ? int(Random_int(max_dests+1)) : 0;
+        for (int n = 0; n < ndests; ++n) {
+            const int who = int(Random_int(nprocs));
+            if (who == myproc) { continue; }
+            not_ours[who].resize(1 + Random_int(1000));
+        }
+
+        Vector<Long> Snds(nprocs, 0), Rcvs(nprocs, 0);
+        doHandShake(not_ours, Snds, Rcvs);
+
+        Vector<int> snd_procs, rcv_procs;
+        Vector<Long> snd_data, rcv_data;
+        for (const auto& kv : not_ours) {
+            snd_procs.push_back(kv.first);
+            snd_data.push_back(static_cast<Long>(kv.second.size()));
+        }
+        ParallelDescriptor::SparseHandShake(snd_procs, snd_data, rcv_procs, rcv_data,
+                                            ParallelDescriptor::SeqNum(),
+                                            ParallelContext::CommunicatorSub());
+
+        AMREX_ALWAYS_ASSERT(rcv_procs.size() == rcv_data.size());
+        Vector<Long> sparse_Rcvs(nprocs, 0);
+        for (int i = 0; i < static_cast<int>(rcv_procs.size()); ++i) {
+            AMREX_ALWAYS_ASSERT(rcv_procs[i] >= 0 && rcv_procs[i] < nprocs);
+            // Each sender is reported once.
+            AMREX_ALWAYS_ASSERT(sparse_Rcvs[rcv_procs[i]] == 0 && rcv_data[i] > 0);
+            sparse_Rcvs[rcv_procs[i]] = rcv_data[i];
+        }
+        AMREX_ALWAYS_ASSERT(sparse_Rcvs == Rcvs);
+    }
+#endif
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+
+    testSparseHandShake();
+    amrex::Print() << "pass \n";
+
+    amrex::Finalize();
+}
@@ -139,6 +139,11 @@ else ()
    add_amrex_define(BL_NO_FORT)
 endif ()
 
+#
+# FFT
+#
+add_amrex_define( AMREX_USE_FFT NO_LEGACY IF AMReX_FFT )
+
 #
 # SENSEI Insitu
 #